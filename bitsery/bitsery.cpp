@@ -23,8 +23,10 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/traits/vector.h>
 #include <bitsery/traits/string.h>
+#include <cstring>
 
 namespace bitsery {
 
@@ -37,7 +39,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -48,16 +50,133 @@ namespace bitsery {
         s.value2b(o.hp);
         s.object(o.equipped);
         s.object(o.pos);
-        s.container(o.path, 10);
-        s.container(o.weapons, 10);
-        s.container1b(o.inventory, 10);
-        s.text1b(o.name, 10);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
+    }
+
+    //pmr twins, must stay in sync with functions above
+    template<typename S>
+    void serialize(S &s, MyTypes::pmr::Weapon &o) {
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
+        s.value2b(o.damage);
+    }
+
+    template<typename S>
+    void serialize(S &s, MyTypes::pmr::Monster &o) {
+        s.value1b(o.color);
+        s.value2b(o.mana);
+        s.value2b(o.hp);
+        s.object(o.equipped);
+        s.object(o.pos);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
     }
 
 }
 
+//zero-copy decoding of bitsery buffer, it follows field order of serialize functions above.
+//bitsery writes values little endian without padding, and sizes in 1, 2 or 4 bytes
+class BitseryViewReader {
+public:
+    explicit BitseryViewReader(Buf buf)
+            : _pos{buf.ptr},
+              _end{buf.ptr + buf.bytesCount} {
+    }
+
+    bool readMonsters(MyTypes::MonstersView &res) {
+        size_t size{};
+        if (!readSize(size))
+            return false;
+        //each weapon takes at least name size and damage
+        res.reset(size, static_cast<size_t>(_end - _pos) / (1 + sizeof(MyTypes::Weapon::damage)));
+        for (auto &m: res.monsters) {
+            if (!readMonster(m, res))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    bool readMonster(MyTypes::MonsterView &m, MyTypes::MonstersView &res) {
+        size_t size{};
+        if (!read(m.color) || !read(m.mana) || !read(m.hp) || !readWeapon(m.equipped) ||
+            !read(m.pos.x) || !read(m.pos.y) || !read(m.pos.z) || !readSize(size))
+            return false;
+        m.path = {_pos, size};
+        if (!skip(size * sizeof(MyTypes::Vec3)) || !readSize(size) || !res.canAddWeapons(size))
+            return false;
+        auto weapons = res.weapons.data() + res.weapons.size();
+        for (size_t i = 0; i < size; ++i) {
+            if (!readWeapon(res.weapons.emplace_back()))
+                return false;
+        }
+        m.weapons = {weapons, size};
+        if (!readSize(size))
+            return false;
+        m.inventory = {_pos, size};
+        return skip(size) && readString(m.name);
+    }
+
+    bool readWeapon(MyTypes::WeaponView &w) {
+        return readString(w.name) && read(w.damage);
+    }
+
+    bool readString(std::string_view &str) {
+        size_t size{};
+        if (!readSize(size))
+            return false;
+        str = {reinterpret_cast<const char *>(_pos), size};
+        return skip(size);
+    }
+
+    bool readSize(size_t &size) {
+        uint8_t hb{};
+        if (!read(hb))
+            return false;
+        if (hb < 0x80u) {
+            size = hb;
+            return true;
+        }
+        uint8_t lb{};
+        if (!read(lb))
+            return false;
+        if (hb & 0x40u) {
+            uint16_t lw{};
+            if (!read(lw))
+                return false;
+            size = ((((hb & 0x3Fu) << 8) | lb) << 16) | lw;
+        } else {
+            size = ((hb & 0x7Fu) << 8) | lb;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool read(T &v) {
+        if (static_cast<size_t>(_end - _pos) < sizeof(T))
+            return false;
+        std::memcpy(&v, _pos, sizeof(T));
+        _pos += sizeof(T);
+        return true;
+    }
+
+    bool skip(size_t bytes) {
+        if (static_cast<size_t>(_end - _pos) < bytes)
+            return false;
+        _pos += bytes;
+        return true;
+    }
+
+    const uint8_t *_pos;
+    const uint8_t *_end;
+};
+
 using Buffer = std::vector<uint8_t>;
-using InputAdapter = bitsery::InputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *>;
 using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
 
 class BitseryArchiver : public ISerializerTest {
@@ -71,11 +190,36 @@ public:
         return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
     }
 
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        return serializeIntoSink(range, sink, [&](auto &ser) {
+            //same size prefix as container writes, see BitseryViewReader::readSize
+            bitsery::details::writeSize(ser.adapter(), range.size());
+            for (auto &m: range)
+                ser.object(m);
+        });
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        bitsery::Deserializer<InputAdapter> des(_buf.begin(), buf.bytesCount);
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
     }
 
+    bool deserializePmr(Buf buf, std::pmr::vector<MyTypes::pmr::Monster> &res) override {
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
+        des.container(res, 100000000);
+        return des.adapter().error() == bitsery::ReaderError::NoError;
+    }
+
+    bool deserializeView(Buf buf, MyTypes::MonstersView &res) override {
+        return BitseryViewReader{buf}.readMonsters(res);
+    }
+
     TestInfo testInfo() const override {
         return {
             SerializationLibrary::BITSERY,
@@ -90,5 +234,5 @@ private:
 
 int main() {
     BitseryArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryArchiver>());
 }
@@ -23,6 +23,7 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/brief_syntax.h>
 #include <bitsery/brief_syntax/vector.h>
 #include <bitsery/brief_syntax/string.h>
@@ -37,19 +38,19 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s(maxSize(o.name, 10),//this maxSize function is optional
+        s(maxSize(o.name, MyTypes::MAX_CONTAINER_SIZE),//this maxSize function is optional
                   o.damage);
     }
 
     template<typename S>
     void serialize(S &s, MyTypes::Monster &o) {
-        s(maxSize(o.name, 10),
+        s(maxSize(o.name, MyTypes::MAX_CONTAINER_SIZE),
                   o.equipped,
-                  maxSize(o.weapons, 10),
+                  maxSize(o.weapons, MyTypes::MAX_CONTAINER_SIZE),
                   o.pos,
-                  maxSize(o.path, 10),
+                  maxSize(o.path, MyTypes::MAX_CONTAINER_SIZE),
                   o.mana,
-                  maxSize(o.inventory, 10),
+                  maxSize(o.inventory, MyTypes::MAX_CONTAINER_SIZE),
                   o.hp,
                   o.color);
     }
@@ -57,7 +58,7 @@ namespace bitsery {
 }
 
 using Buffer = std::vector<uint8_t>;
-using InputAdapter = bitsery::InputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *>;
 using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
 
 class BitseryVerboseSyntaxArchiver : public ISerializerTest {
@@ -71,8 +72,14 @@ public:
         return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        bitsery::Deserializer<InputAdapter> des(_buf.begin(), buf.bytesCount);
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
     }
 
@@ -90,5 +97,5 @@ private:
 
 int main() {
     BitseryVerboseSyntaxArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryVerboseSyntaxArchiver>());
 }
@@ -23,6 +23,7 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/traits/vector.h>
 #include <bitsery/traits/string.h>
 //enable forward/backward compatibility
@@ -39,7 +40,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -52,10 +53,10 @@ namespace bitsery {
             s.value2b(o1.hp);
             s.object(o1.equipped);
             s.object(o1.pos);
-            s.container(o1.path, 10);
-            s.container(o1.weapons, 10);
-            s.container1b(o1.inventory, 10);
-            s.text1b(o1.name, 10);
+            s.container(o1.path, MyTypes::MAX_CONTAINER_SIZE);
+            s.container(o1.weapons, MyTypes::MAX_CONTAINER_SIZE);
+            s.container1b(o1.inventory, MyTypes::MAX_CONTAINER_SIZE);
+            s.text1b(o1.name, MyTypes::MAX_CONTAINER_SIZE);
         });
     }
 }
@@ -66,7 +67,7 @@ struct SessionEnabled : public bitsery::DefaultConfig {
 };
 
 using Buffer = std::vector<uint8_t>;
-using InputAdapter = bitsery::InputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *>;
 using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
 
 class BitseryCompatibilityArchiver : public ISerializerTest {
@@ -80,8 +81,14 @@ public:
         return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        bitsery::Deserializer<InputAdapter> des( _buf.begin(), buf.bytesCount );
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
     }
 
@@ -99,5 +106,5 @@ private:
 
 int main() {
     BitseryCompatibilityArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryCompatibilityArchiver>());
 }
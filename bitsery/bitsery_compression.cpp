@@ -23,6 +23,7 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/traits/vector.h>
 #include <bitsery/traits/string.h>
 //enable compression
@@ -42,7 +43,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -53,16 +54,16 @@ namespace bitsery {
         s.value2b(o.hp);
         s.object(o.equipped);
         s.object(o.pos);
-        s.container(o.path, 10);
-        s.container(o.weapons, 10);
-        s.container1b(o.inventory, 10);
-        s.text1b(o.name, 10);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
     }
 
 }
 
 using Buffer = std::vector<uint8_t>;
-using InputAdapter = bitsery::InputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *>;
 using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
 
 class BitseryCompressionArchiver : public ISerializerTest {
@@ -76,8 +77,14 @@ public:
         return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        bitsery::Deserializer<InputAdapter> des(_buf.begin(), buf.bytesCount);
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
     }
 
@@ -95,5 +102,5 @@ private:
 
 int main() {
     BitseryCompressionArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryCompressionArchiver>());
 }
@@ -0,0 +1,247 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include <testing/test.h>
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
+#include <bitsery/traits/vector.h>
+#include <bitsery/traits/string.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BITSERY_QUANTIZE_X86
+#include <immintrin.h>
+#endif
+
+//Vec3 components are quantized in bulk, same range and precision as compression test: [-1.0, 1.0] with 0.01.
+//201 levels need 8 bits, so every component is packed into one byte.
+//scalar and AVX2 kernels round the same way (to nearest even) and map NaN to level 0, so their results are identical
+namespace quantization {
+
+    constexpr float RANGE_MIN = -1.0f;
+    constexpr float RANGE_MAX = 1.0f;
+    constexpr float PRECISION = 0.01f;
+
+    constexpr unsigned requiredBits(float levels) {
+        unsigned bits = 0;
+        while (static_cast<float>(1u << bits) < levels + 1.0f)
+            ++bits;
+        return bits;
+    }
+
+    constexpr unsigned BITS = requiredBits((RANGE_MAX - RANGE_MIN) / PRECISION);
+    static_assert(BITS == 8, "kernels pack one component per byte");
+    constexpr float MAX_LEVEL = static_cast<float>((1u << BITS) - 1);
+    constexpr float SCALE = MAX_LEVEL / (RANGE_MAX - RANGE_MIN);
+    constexpr float INV_SCALE = 1.0f / SCALE;
+
+    void quantizeScalar(const float *src, uint8_t *dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            //written so that NaN fails the comparison and maps to level 0, same as _mm256_max_ps in AVX2 kernel
+            const auto scaled = (src[i] - RANGE_MIN) * SCALE;
+            const auto v = !(scaled > 0.0f) ? 0.0f : std::min(scaled, MAX_LEVEL);
+            dst[i] = static_cast<uint8_t>(std::nearbyint(v));
+        }
+    }
+
+    void dequantizeScalar(const uint8_t *src, float *dst, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = static_cast<float>(src[i]) * INV_SCALE + RANGE_MIN;
+    }
+
+#ifdef BITSERY_QUANTIZE_X86
+
+    //32 floats per step: convert to int32, narrow to bytes with saturating packs, and undo packs lane interleaving
+    __attribute__((target("avx2")))
+    void quantizeAvx2(const float *src, uint8_t *dst, size_t count) {
+        const auto min = _mm256_set1_ps(RANGE_MIN);
+        const auto scale = _mm256_set1_ps(SCALE);
+        const auto low = _mm256_setzero_ps();
+        const auto high = _mm256_set1_ps(MAX_LEVEL);
+        const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m256i q[4];
+            for (size_t k = 0; k < 4; ++k) {
+                auto v = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(src + i + 8 * k), min), scale);
+                v = _mm256_min_ps(_mm256_max_ps(v, low), high);
+                q[k] = _mm256_cvtps_epi32(v);
+            }
+            const auto bytes = _mm256_packus_epi16(_mm256_packs_epi32(q[0], q[1]), _mm256_packs_epi32(q[2], q[3]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_permutevar8x32_epi32(bytes, order));
+        }
+        quantizeScalar(src + i, dst + i, count - i);
+    }
+
+    __attribute__((target("avx2")))
+    void dequantizeAvx2(const uint8_t *src, float *dst, size_t count) {
+        const auto min = _mm256_set1_ps(RANGE_MIN);
+        const auto invScale = _mm256_set1_ps(INV_SCALE);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto q = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i)));
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(q), invScale), min));
+        }
+        dequantizeScalar(src + i, dst + i, count - i);
+    }
+
+#endif
+
+    struct Kernels {
+        void (*quantize)(const float *, uint8_t *, size_t);
+        void (*dequantize)(const uint8_t *, float *, size_t);
+        const char *name;
+    };
+
+    //best kernels that current cpu supports
+    const Kernels &kernels() {
+        static const Kernels selected = [] {
+#ifdef BITSERY_QUANTIZE_X86
+            if (__builtin_cpu_supports("avx2"))
+                return Kernels{quantizeAvx2, dequantizeAvx2, "AVX2"};
+#endif
+            return Kernels{quantizeScalar, dequantizeScalar, "scalar"};
+        }();
+        return selected;
+    }
+
+    static_assert(sizeof(MyTypes::Vec3) == 3 * sizeof(float), "Vec3 arrays are quantized as float arrays");
+
+    //quantized bytes of Vec3 array are written as byte container
+    template<typename S>
+    void write(S &s, const MyTypes::Vec3 *points, size_t count, size_t maxCount, std::vector<uint8_t> &scratch) {
+        scratch.resize(3 * count);
+        kernels().quantize(reinterpret_cast<const float *>(points), scratch.data(), scratch.size());
+        s.container1b(scratch, 3 * maxCount);
+    }
+
+    template<typename S>
+    bool read(S &s, std::vector<MyTypes::Vec3> &points, size_t maxCount, std::vector<uint8_t> &scratch) {
+        s.container1b(scratch, 3 * maxCount);
+        if (scratch.size() % 3 != 0)
+            return false;
+        points.resize(scratch.size() / 3);
+        kernels().dequantize(scratch.data(), reinterpret_cast<float *>(points.data()), scratch.size());
+        return true;
+    }
+
+}
+
+//bitsery uses same serialize function for both directions, serializer is told apart by its output adapter
+template<typename S>
+constexpr bool isSerializer = requires(S &s) { s.adapter().writtenBytesCount(); };
+
+//serializes Vec3 array with quantization kernels, instead of one component at a time
+template<typename S>
+void quantizedPath(S &s, std::vector<MyTypes::Vec3> &path) {
+    thread_local std::vector<uint8_t> scratch{};
+    if constexpr (isSerializer<S>) {
+        quantization::write(s, path.data(), path.size(), MyTypes::MAX_CONTAINER_SIZE, scratch);
+    } else {
+        if (!quantization::read(s, path, MyTypes::MAX_CONTAINER_SIZE, scratch))
+            s.adapter().error(bitsery::ReaderError::InvalidData);
+    }
+}
+
+namespace bitsery {
+
+    template<typename S>
+    void serialize(S &s, MyTypes::Weapon &o) {
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
+        s.value2b(o.damage);
+    }
+
+    //pos of all monsters is written as one quantized column after monsters
+    template<typename S>
+    void serialize(S &s, MyTypes::Monster &o) {
+        s.value1b(o.color);
+        s.value2b(o.mana);
+        s.value2b(o.hp);
+        s.object(o.equipped);
+        quantizedPath(s, o.path);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
+    }
+
+}
+
+using Buffer = std::vector<uint8_t>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *>;
+using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+
+class BitseryCompressionSimdArchiver : public ISerializerTest {
+public:
+
+    Buf serialize(const std::vector<MyTypes::Monster> &data) override {
+        _buf.clear();
+        bitsery::Serializer<OutputAdapter> ser(_buf);
+        write(ser, data);
+        ser.adapter().flush();
+        return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            write(ser, data);
+        });
+    }
+
+    void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
+        des.container(res, MAX_MONSTERS);
+        if (!quantization::read(des, _positions, MAX_MONSTERS, _scratch) || _positions.size() != res.size())
+            return;
+        for (size_t i = 0; i < res.size(); ++i)
+            res[i].pos = _positions[i];
+    }
+
+    TestInfo testInfo() const override {
+        return {
+                SerializationLibrary::BITSERY,
+                "compression simd",
+                std::string{"Vec3 arrays are compressed in [-1.0, 1.0] range with precision 0.01 in bulk with "} +
+                quantization::kernels().name + ", pos of all monsters as one array"
+        };
+    }
+
+private:
+    static constexpr size_t MAX_MONSTERS = 100000000;
+
+    template<typename S>
+    void write(S &ser, const std::vector<MyTypes::Monster> &data) {
+        ser.container(data, MAX_MONSTERS);
+        _positions.resize(data.size());
+        std::transform(data.begin(), data.end(), _positions.begin(), [](const MyTypes::Monster &m) { return m.pos; });
+        quantization::write(ser, _positions.data(), _positions.size(), MAX_MONSTERS, _scratch);
+    }
+
+    Buffer _buf{};
+    std::vector<MyTypes::Vec3> _positions{};
+    std::vector<uint8_t> _scratch{};
+};
+
+int main() {
+    BitseryCompressionSimdArchiver test{};
+    return runTest(test, makeTestFactory<BitseryCompressionSimdArchiver>());
+}
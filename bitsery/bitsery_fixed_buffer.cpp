@@ -23,6 +23,7 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/traits/vector.h>
 #include <bitsery/traits/string.h>
 
@@ -37,7 +38,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -48,10 +49,10 @@ namespace bitsery {
         s.value2b(o.hp);
         s.object(o.equipped);
         s.object(o.pos);
-        s.container(o.path, 10);
-        s.container(o.weapons, 10);
-        s.container1b(o.inventory, 10);
-        s.text1b(o.name, 10);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
     }
 
 }
@@ -71,6 +72,12 @@ public:
 
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
         bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
@@ -84,11 +91,15 @@ public:
         };
     }
 
+    size_t bufferCapacity() const override {
+        return sizeof(_buf);
+    }
+
 private:
     Buffer _buf{};
 };
 
 int main() {
     BitseryFixedBufferArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryFixedBufferArchiver>());
 }
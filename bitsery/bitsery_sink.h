@@ -0,0 +1,86 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_BITSERY_SINK_H
+#define CPP_SERIALIZERS_BENCHMARK_BITSERY_SINK_H
+
+#include <testing/test.h>
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/traits/core/traits.h>
+
+//non-resizable buffer over caller's memory, so serializeInto writes directly into OutputSink.
+//non-resizable buffer adapter doesn't report overflow, so callers check MyTypes::serializedSizeUpperBound first
+struct SinkBuffer {
+    uint8_t *ptr;
+    size_t capacity;
+
+    uint8_t *begin() const {
+        return ptr;
+    }
+
+    uint8_t *end() const {
+        return ptr + capacity;
+    }
+
+    size_t size() const {
+        return capacity;
+    }
+};
+
+namespace bitsery::traits {
+
+    template<>
+    struct ContainerTraits<SinkBuffer> {
+        using TValue = uint8_t;
+        static constexpr bool isResizable = false;
+        static constexpr bool isContiguous = true;
+
+        static size_t size(const SinkBuffer &buffer) {
+            return buffer.capacity;
+        }
+    };
+
+    template<>
+    struct BufferAdapterTraits<SinkBuffer> {
+        using TIterator = uint8_t *;
+        using TConstIterator = const uint8_t *;
+        using TValue = uint8_t;
+    };
+
+}
+
+template<typename Config = bitsery::DefaultConfig>
+using SinkOutputAdapter = bitsery::OutputBufferAdapter<SinkBuffer, Config>;
+
+//writes with serializer over sink memory, returns written bytes or 0 if data might not fit
+template<typename Config = bitsery::DefaultConfig, typename Fnc>
+size_t serializeIntoSink(std::span<const MyTypes::Monster> data, OutputSink sink, Fnc &&write) {
+    if (MyTypes::serializedSizeUpperBound(data) > sink.capacity)
+        return 0;
+    SinkBuffer buffer{sink.ptr, sink.capacity};
+    bitsery::Serializer<SinkOutputAdapter<Config>> ser(buffer);
+    write(ser);
+    ser.adapter().flush();
+    return ser.adapter().writtenBytesCount();
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_BITSERY_SINK_H
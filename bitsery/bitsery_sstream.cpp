@@ -21,6 +21,7 @@
 //SOFTWARE.
 
 #include <testing/test.h>
+#include <testing/memory_stream.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/stream.h>
 #include <bitsery/traits/vector.h>
@@ -38,7 +39,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -49,10 +50,10 @@ namespace bitsery {
         s.value2b(o.hp);
         s.object(o.equipped);
         s.object(o.pos);
-        s.container(o.path, 10);
-        s.container(o.weapons, 10);
-        s.container1b(o.inventory, 10);
-        s.text1b(o.name, 10);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
     }
 
 }
@@ -70,10 +71,8 @@ public:
         bitsery::Serializer<OutputAdapter> ser(ss);
         ser.container(data, 100000000);
         ser.adapter().flush();
-        //copy only once to permanent buffer
-        if (_buf.empty()) {
-            _buf = ss.str();
-        }
+        //move out stream's string, so result is always up to date without extra copy
+        _buf = std::move(ss).str();
 
         return {
                 reinterpret_cast<uint8_t *>(std::addressof(*_buf.begin())),
@@ -81,8 +80,17 @@ public:
         };
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        MemoryStreamBuf sb{sink};
+        std::ostream os{&sb};
+        bitsery::Serializer<OutputAdapter> ser(os);
+        ser.container(data, 100000000);
+        ser.adapter().flush();
+        return sb.overflowed() ? 0 : sb.written();
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        std::stringstream ss(_buf);
+        std::stringstream ss(std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount});
         bitsery::Deserializer<InputAdapter> des(ss);
         des.container(res, 100000000);
     }
@@ -101,5 +109,5 @@ private:
 
 int main() {
     BitseryStreamArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryStreamArchiver>());
 }
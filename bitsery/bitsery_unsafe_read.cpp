@@ -23,6 +23,7 @@
 #include <testing/test.h>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include "bitsery_sink.h"
 #include <bitsery/traits/vector.h>
 #include <bitsery/traits/string.h>
 
@@ -37,7 +38,7 @@ namespace bitsery {
 
     template<typename S>
     void serialize(S &s, MyTypes::Weapon &o) {
-        s.text1b(o.name, 10);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
         s.value2b(o.damage);
     }
 
@@ -48,10 +49,10 @@ namespace bitsery {
         s.value2b(o.hp);
         s.object(o.equipped);
         s.object(o.pos);
-        s.container(o.path, 10);
-        s.container(o.weapons, 10);
-        s.container1b(o.inventory, 10);
-        s.text1b(o.name, 10);
+        s.container(o.path, MyTypes::MAX_CONTAINER_SIZE);
+        s.container(o.weapons, MyTypes::MAX_CONTAINER_SIZE);
+        s.container1b(o.inventory, MyTypes::MAX_CONTAINER_SIZE);
+        s.text1b(o.name, MyTypes::MAX_CONTAINER_SIZE);
     }
 
 }
@@ -63,7 +64,7 @@ struct DisableErrorChecksConfig {
 };
 
 using Buffer = std::vector<uint8_t>;
-using InputAdapter = bitsery::InputBufferAdapter<Buffer, DisableErrorChecksConfig>;
+using InputAdapter = bitsery::InputBufferAdapter<const uint8_t *, DisableErrorChecksConfig>;
 using OutputAdapter = bitsery::OutputBufferAdapter<Buffer, DisableErrorChecksConfig>;
 
 class BitseryUnsafeArchiver : public ISerializerTest {
@@ -78,8 +79,14 @@ public:
         return Buf{std::addressof(*std::begin(_buf)), ser.adapter().writtenBytesCount()};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeIntoSink<DisableErrorChecksConfig>(data, sink, [&](auto &ser) {
+            ser.container(data, 100000000);
+        });
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        bitsery::Deserializer<InputAdapter> des(_buf.begin(), buf.bytesCount);
+        bitsery::Deserializer<InputAdapter> des(buf.ptr, buf.bytesCount);
         des.container(res, 100000000);
     }
 
@@ -97,5 +104,5 @@ private:
 
 int main() {
     BitseryUnsafeArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<BitseryUnsafeArchiver>());
 }
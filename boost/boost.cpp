@@ -21,6 +21,7 @@
 //SOFTWARE.
 
 #include <testing/test.h>
+#include <testing/memory_stream.h>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -58,16 +59,28 @@ public:
 
         archive << data;
 
-        if (_buf.empty())
-            _buf = _stream.str();
+        //move out stream's string, so result is always up to date without extra copy
+        _buf = std::move(_stream).str();
         return {
                 reinterpret_cast<uint8_t *>(std::addressof(*_buf.begin())),
                 _buf.size()
         };
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        MemoryStreamBuf sb{sink};
+        std::ostream os{&sb};
+        try {
+            boost::archive::binary_oarchive archive(os);
+            archive << data;
+        } catch (const boost::archive::archive_exception&) {
+            return 0;
+        }
+        return sb.overflowed() ? 0 : sb.written();
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
-        std::stringstream stream(_buf);
+        std::stringstream stream(std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount});
         boost::archive::binary_iarchive archive(stream);
 
         archive >> resVec;
@@ -87,5 +100,5 @@ private:
 
 int main() {
     BoostArchiver test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<BoostArchiver>());
 }
@@ -21,6 +21,7 @@
 //SOFTWARE.
 
 #include <testing/test.h>
+#include <testing/memory_stream.h>
 #include <cereal/archives/binary.hpp>
 #include <cereal/types/vector.hpp>
 #include <cereal/types/string.hpp>
@@ -42,6 +43,17 @@ namespace cereal {
         archive(o.name, o.equipped, o.weapons, o.pos, o.path, o.mana, o.inventory, o.hp, o.color);
     }
 
+
+    //pmr twins, must stay in sync with functions above
+    template<typename Archive>
+    void serialize(Archive &archive, MyTypes::pmr::Weapon &o) {
+        archive(o.name, o.damage);
+    }
+
+    template<typename Archive>
+    void serialize(Archive &archive, MyTypes::pmr::Monster &o) {
+        archive(o.name, o.equipped, o.weapons, o.pos, o.path, o.mana, o.inventory, o.hp, o.color);
+    }
 }
 
 class CerealArchiver : public ISerializerTest {
@@ -52,21 +64,44 @@ public:
 
         archive(data);
 
-        if (_buf.empty())
-            _buf = _stream.str();
+        //move out stream's string, so result is always up to date without extra copy
+        _buf = std::move(_stream).str();
         return {
                 reinterpret_cast<uint8_t *>(std::addressof(*_buf.begin())),
                 _buf.size()
         };
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        MemoryStreamBuf sb{sink};
+        std::ostream os{&sb};
+        try {
+            cereal::BinaryOutputArchive archive(os);
+            archive(data);
+        } catch (const cereal::Exception&) {
+            return 0;
+        }
+        return sb.overflowed() ? 0 : sb.written();
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
-        std::stringstream stream(_buf);
+        std::stringstream stream(std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount});
         cereal::BinaryInputArchive archive(stream);
 
         archive(resVec);
     }
 
+    bool deserializePmr(Buf buf, std::pmr::vector<MyTypes::pmr::Monster> &res) override {
+        std::stringstream stream(std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount});
+        try {
+            cereal::BinaryInputArchive archive(stream);
+            archive(res);
+        } catch (const cereal::Exception&) {
+            return false;
+        }
+        return true;
+    }
+
     TestInfo testInfo() const override {
         return {
                 SerializationLibrary::CEREAL,
@@ -81,5 +116,5 @@ private:
 
 int main() {
     CerealArchiver test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<CerealArchiver>());
 }
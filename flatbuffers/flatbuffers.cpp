@@ -22,20 +22,73 @@
 
 #include <testing/test.h>
 #include <algorithm>
+#include <cstring>
 #include "monster_generated.h"
 
 using namespace MyGame::Sample;
 
+//gives whole caller's sink to FlatBufferBuilder as its only allocation.
+//builder grows by reallocating into bigger buffer, sink can't grow, so growing throws Overflow
+class SinkAllocator : public flatbuffers::Allocator {
+public:
+    struct Overflow {
+    };
+
+    explicit SinkAllocator(OutputSink sink) : _sink{sink} {
+    }
+
+    uint8_t *allocate(size_t size) override {
+        if (_allocated || size > _sink.capacity)
+            throw Overflow{};
+        _allocated = true;
+        return _sink.ptr;
+    }
+
+    void deallocate(uint8_t *, size_t) override {
+    }
+
+    uint8_t *reallocate_downward(uint8_t *, size_t, size_t, size_t, size_t) override {
+        throw Overflow{};
+    }
+
+private:
+    OutputSink _sink;
+    bool _allocated{};
+};
+
 class FlatbuffersArchiver : public ISerializerTest {
 public:
 
-    auto createWeapon(flatbuffers::FlatBufferBuilder &builder, const MyTypes::Weapon &weapon) {
+    static auto createWeapon(flatbuffers::FlatBufferBuilder &builder, const MyTypes::Weapon &weapon) {
         auto name = builder.CreateString(weapon.name);
         return CreateWeapon(builder, name, weapon.damage);
     }
 
     Buf serialize(const std::vector<MyTypes::Monster> &data) override {
         _builder.Clear();
+        build(_builder, data);
+        return Buf{_builder.GetBufferPointer(), _builder.GetSize()};
+    }
+
+    //builder writes back to front, so it builds at the end of sink and finished buffer is moved to its start
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        //builder rounds its buffer size up to alignment, round down to stay inside sink
+        constexpr size_t align = alignof(flatbuffers::largest_scalar_t);
+        if (sink.capacity < align)
+            return 0;
+        SinkAllocator allocator{sink};
+        flatbuffers::FlatBufferBuilder builder(sink.capacity & ~(align - 1), &allocator, false, align);
+        try {
+            build(builder, data);
+        } catch (const SinkAllocator::Overflow &) {
+            return 0;
+        }
+        const auto size = builder.GetSize();
+        std::memmove(sink.ptr, builder.GetBufferPointer(), size);
+        return size;
+    }
+
+    static void build(flatbuffers::FlatBufferBuilder &builder, const std::vector<MyTypes::Monster> &data) {
         std::vector<flatbuffers::Offset < Monster>>
         monstersVec{};
         monstersVec.reserve(data.size());
@@ -45,22 +98,22 @@ public:
             weaponsVec{};
             weaponsVec.reserve(m.weapons.size());
             for (auto &w:m.weapons)
-                weaponsVec.push_back(createWeapon(_builder, w));
-            auto weapons = _builder.CreateVector(weaponsVec);
+                weaponsVec.push_back(createWeapon(builder, w));
+            auto weapons = builder.CreateVector(weaponsVec);
 
             // Second, serialize the rest of the objects needed by the Monster.
             auto position = Vec3(m.pos.x, m.pos.y, m.pos.z);
-            auto name = _builder.CreateString(m.name);
-            auto inventory = _builder.CreateVector(m.inventory);
+            auto name = builder.CreateString(m.name);
+            auto inventory = builder.CreateVector(m.inventory);
             std::vector<Vec3> pathVec{};
             pathVec.reserve(m.path.size());
             for (auto &p:m.path)
                 pathVec.push_back(Vec3(p.x, p.y, p.z));
-            auto path = _builder.CreateVectorOfStructs(pathVec);
+            auto path = builder.CreateVectorOfStructs(pathVec);
 
             // Shortcut for creating monster with all fields set:
             monstersVec.push_back(
-                    CreateMonster(_builder,
+                    CreateMonster(builder,
                                   &position,
                                   m.mana,
                                   m.hp,
@@ -68,13 +121,12 @@ public:
                                   inventory,
                                   static_cast<Color>(m.color),
                                   weapons,
-                                  createWeapon(_builder, m.equipped),
+                                  createWeapon(builder, m.equipped),
                                   path));
         }
-        auto monsters = _builder.CreateVector(monstersVec);
-        auto root = CreateMonstersList(_builder, monsters);
-        _builder.Finish(root);
-        return Buf{_builder.GetBufferPointer(), _builder.GetSize()};
+        auto monsters = builder.CreateVector(monstersVec);
+        auto root = CreateMonstersList(builder, monsters);
+        builder.Finish(root);
     }
 
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
@@ -84,43 +136,77 @@ public:
             auto data = monsters->data();
             res.resize(data->size());
             for (auto i = 0u; i < data->size(); ++i) {
-                auto m = data->Get(i);
-                auto &resM = res[i];
-                resM.equipped = MyTypes::Weapon{m->equipped()->name()->data(), m->equipped()->damage()};
-                resM.name.resize(m->name()->size());
-                //cannot memcpy, because data is not contigous on flatbuffers
-                std::copy(m->name()->begin(), m->name()->end(), resM.name.begin());
-                resM.color = static_cast<MyTypes::Color>(m->color());
-                resM.hp = m->hp();
-                resM.mana = m->mana();
-                resM.pos = MyTypes::Vec3{m->pos()->x(), m->pos()->y(), m->pos()->z()};
-                resM.inventory.resize(m->inventory()->size());
-                std::copy(m->inventory()->begin(), m->inventory()->end(), resM.inventory.begin());
-                resM.weapons.resize(m->weapons()->size());
-                std::transform(m->weapons()->begin(), m->weapons()->end(), resM.weapons.begin(), [](const auto &w) {
-                    return MyTypes::Weapon{w->name()->data(), w->damage()};
-                });
-                resM.path.resize(m->path()->size());
-                std::transform(m->path()->begin(), m->path()->end(), resM.path.begin(), [](const auto &p) {
-                    return MyTypes::Vec3{p->x(), p->y(), p->z()};
-                });
+                convertMonster(data->Get(i), res[i]);
             }
         }
     };
 
+    bool hasDirectAccess() const override {
+        return true;
+    }
+
+    //buffer is trusted here, verifying it would touch whole buffer, but index is checked
+    int16_t readHp(Buf buf, size_t index) override {
+        auto m = monsterAt(buf, index);
+        return m ? m->hp() : int16_t{};
+    }
+
+    MyTypes::Vec3 readPos(Buf buf, size_t index) override {
+        auto m = monsterAt(buf, index);
+        if (!m)
+            return {};
+        auto pos = m->pos();
+        return MyTypes::Vec3{pos->x(), pos->y(), pos->z()};
+    }
+
+    void readMonster(Buf buf, size_t index, MyTypes::Monster &res) override {
+        if (auto m = monsterAt(buf, index))
+            convertMonster(m, res);
+    }
+
     TestInfo testInfo() const override {
         return {
                 SerializationLibrary::FLATBUFFERS,
                 "general",
-                ""
+                "`serializeInto` builds at the end of caller's buffer and moves result to its start, "
+                "because builder writes back to front"
         };
     }
 
 private:
+    //nullptr if index is out of range
+    static const Monster *monsterAt(Buf buf, size_t index) {
+        auto data = GetMonstersList(buf.ptr)->data();
+        if (index >= data->size())
+            return nullptr;
+        return data->Get(static_cast<flatbuffers::uoffset_t>(index));
+    }
+
+    static void convertMonster(const Monster *m, MyTypes::Monster &resM) {
+        resM.equipped = MyTypes::Weapon{m->equipped()->name()->data(), m->equipped()->damage()};
+        resM.name.resize(m->name()->size());
+        //cannot memcpy, because data is not contigous on flatbuffers
+        std::copy(m->name()->begin(), m->name()->end(), resM.name.begin());
+        resM.color = static_cast<MyTypes::Color>(m->color());
+        resM.hp = m->hp();
+        resM.mana = m->mana();
+        resM.pos = MyTypes::Vec3{m->pos()->x(), m->pos()->y(), m->pos()->z()};
+        resM.inventory.resize(m->inventory()->size());
+        std::copy(m->inventory()->begin(), m->inventory()->end(), resM.inventory.begin());
+        resM.weapons.resize(m->weapons()->size());
+        std::transform(m->weapons()->begin(), m->weapons()->end(), resM.weapons.begin(), [](const auto &w) {
+            return MyTypes::Weapon{w->name()->data(), w->damage()};
+        });
+        resM.path.resize(m->path()->size());
+        std::transform(m->path()->begin(), m->path()->end(), resM.path.begin(), [](const auto &p) {
+            return MyTypes::Vec3{p->x(), p->y(), p->z()};
+        });
+    }
+
     flatbuffers::FlatBufferBuilder _builder;
 };
 
 int main() {
     FlatbuffersArchiver test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<FlatbuffersArchiver>());
 }
\ No newline at end of file
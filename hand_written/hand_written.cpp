@@ -30,29 +30,20 @@ public:
     Buf serialize(const std::vector<MyTypes::Monster> &data) override {
         auto begin = std::addressof(*_buf.begin());
         _pos = begin;
-        writeSize(data.size());
-        for (auto &m:data) {
-            write(m.hp);
-            write(m.mana);
-            writeSize(m.name.size());
-            write(m.name.data(), m.name.size());
-            write(static_cast<const typename std::underlying_type<MyTypes::Color>::type &>(m.color));
-            writeSize(m.inventory.size());
-            write(m.inventory.data(), m.inventory.size());
-            writeSize(m.weapons.size());
-            for (auto &w:m.weapons) {
-                writeWeapon(w);
-            }
-            writeSize(m.path.size());
-            for (auto &p:m.path) {
-                writeVec(p);
-            }
-            writeWeapon(m.equipped);
-            writeVec(m.pos);
-        }
+        writeMonsters<false>(data);
         return {begin, static_cast<size_t >(std::distance(begin, _pos))};
     }
 
+    bool serializeGather(const std::vector<MyTypes::Monster> &data, std::vector<Buf> &segments) override {
+        _segments = &segments;
+        segments.clear();
+        _pos = std::addressof(*_buf.begin());
+        _segmentBegin = _pos;
+        writeMonsters<true>(data);
+        endSegment();
+        return true;
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
         _pos = const_cast<uint8_t *>(buf.ptr);
         _end = std::next(_pos, buf.bytesCount);
@@ -62,33 +53,94 @@ public:
             return;
         res.resize(size);
         for (auto &m:res) {
-            read(m.hp);
-            read(m.mana);
-            readSize(size);
-            if (size > 100) return;
-            m.name.resize(size);
-            read(const_cast<char *>(m.name.data()), size);
-            read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color));
-            readSize(size);
-            if (size > 100) return;
-            m.inventory.resize(size);
-            read(m.inventory.data(), size);
-            readSize(size);
-            if (size > 100) return;
-            m.weapons.resize(size);
-            for (auto &w:m.weapons) {
-                readWeapon(w);
-            }
-            readSize(size);
-            if (size > 100) return;
-            m.path.resize(size);
-            for (auto &p:m.path) {
-                readVec(p);
-            }
-            readWeapon(m.equipped);
-            readVec(m.pos);
+            if (!decodeMonster(m))
+                return;
         }
+    }
+
+    bool deserializeRange(Buf buf, std::span<MyTypes::Monster> res) override {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (size != res.size())
+            return false;
+        for (auto &m:res) {
+            if (!decodeMonster(m))
+                return false;
+        }
+        return true;
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeRangeInto(data, sink);
+    }
+
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        //writing is unchecked, so make sure upfront that the result fits
+        if (MyTypes::serializedSizeUpperBound(range) > sink.capacity)
+            return 0;
+        _pos = sink.ptr;
+        writeMonsters<false>(range);
+        return static_cast<size_t>(std::distance(sink.ptr, _pos));
+    }
 
+    bool hasDirectAccess() const override {
+        return true;
+    }
+
+    int16_t readHp(Buf buf, size_t index) override {
+        int16_t hp{};
+        //hp is first field of monster
+        if (seekMonster(buf, index))
+            read(hp);
+        return hp;
+    }
+
+    MyTypes::Vec3 readPos(Buf buf, size_t index) override {
+        MyTypes::Vec3 pos{};
+        //pos is last field of monster
+        if (seekMonster(buf, index) && skipMonster()) {
+            _pos -= 3 * sizeof(float);
+            readVec(pos);
+        }
+        return pos;
+    }
+
+    void readMonster(Buf buf, size_t index, MyTypes::Monster &res) override {
+        if (seekMonster(buf, index))
+            decodeMonster(res);
+    }
+
+    bool deserializePmr(Buf buf, std::pmr::vector<MyTypes::pmr::Monster> &res) override {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (size > 1000000)
+            return false;
+        res.resize(size);
+        for (auto &m:res) {
+            if (!decodeMonster(m))
+                return false;
+        }
+        return true;
+    }
+
+    bool deserializeView(Buf buf, MyTypes::MonstersView &res) override {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (size > 1000000)
+            return false;
+        //each weapon takes at least damage and name size
+        res.reset(size, buf.bytesCount / (sizeof(MyTypes::Weapon::damage) + sizeof(size_t)));
+        for (auto &m:res.monsters) {
+            if (!decodeMonsterView(m, res))
+                return false;
+        }
+        return true;
     }
 
     TestInfo testInfo() const override {
@@ -99,12 +151,196 @@ public:
         };
     }
 
+    size_t bufferCapacity() const override {
+        return _buf.size();
+    }
+
 private:
 
+    //in gather mode, byte arrays of at least this size are referenced in place instead of copied into _buf
+    static constexpr size_t GATHER_MIN_BYTES = 256;
+
+    template<bool Gather>
+    void writeMonsters(std::span<const MyTypes::Monster> data) {
+        writeSize(data.size());
+        for (auto &m:data) {
+            write(m.hp);
+            write(m.mana);
+            writeSize(m.name.size());
+            writeBytes<Gather>(m.name.data(), m.name.size());
+            write(static_cast<const typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+            writeSize(m.inventory.size());
+            writeBytes<Gather>(m.inventory.data(), m.inventory.size());
+            writeSize(m.weapons.size());
+            for (auto &w:m.weapons) {
+                writeWeapon<Gather>(w);
+            }
+            writeSize(m.path.size());
+            //Vec3 has same layout as written floats
+            if (Gather && m.path.size() * sizeof(MyTypes::Vec3) >= GATHER_MIN_BYTES) {
+                writeBytes<Gather>(m.path.data(), m.path.size());
+            } else {
+                for (auto &p:m.path) {
+                    writeVec(p);
+                }
+            }
+            writeWeapon<Gather>(m.equipped);
+            writeVec(m.pos);
+        }
+    }
+
+    template<bool Gather, typename T>
+    void writeBytes(const T *v, size_t count) {
+        const auto size = count * sizeof(T);
+        if (Gather && size >= GATHER_MIN_BYTES) {
+            endSegment();
+            _segments->push_back(Buf{reinterpret_cast<const uint8_t *>(v), size});
+            _segmentBegin = _pos;
+        } else {
+            write(v, count);
+        }
+    }
+
+    //adds bytes written to _buf since last referenced array as segment
+    void endSegment() {
+        if (_pos != _segmentBegin)
+            _segments->push_back(Buf{_segmentBegin, static_cast<size_t>(std::distance(_segmentBegin, _pos))});
+    }
+
+    //Monster or pmr::Monster
+    template<typename Monster>
+    bool decodeMonster(Monster &m) {
+        size_t size;
+        read(m.hp);
+        read(m.mana);
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.name.resize(size);
+        read(const_cast<char *>(m.name.data()), size);
+        read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.inventory.resize(size);
+        read(m.inventory.data(), size);
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.weapons.resize(size);
+        for (auto &w:m.weapons) {
+            readWeapon(w);
+        }
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.path.resize(size);
+        for (auto &p:m.path) {
+            readVec(p);
+        }
+        readWeapon(m.equipped);
+        readVec(m.pos);
+        return true;
+    }
+
+    bool decodeMonsterView(MyTypes::MonsterView &m, MyTypes::MonstersView &res) {
+        size_t size{};
+        read(m.hp);
+        read(m.mana);
+        readSize(size);
+        auto name = readView(size);
+        if (!name) return false;
+        m.name = {reinterpret_cast<const char *>(name), size};
+        read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+        readSize(size);
+        auto inventory = readView(size);
+        if (!inventory) return false;
+        m.inventory = {inventory, size};
+        readSize(size);
+        if (!res.canAddWeapons(size)) return false;
+        auto weapons = res.weapons.data() + res.weapons.size();
+        for (size_t i = 0; i < size; ++i) {
+            if (!readWeaponView(res.weapons.emplace_back())) return false;
+        }
+        m.weapons = {weapons, size};
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        auto path = readView(size * sizeof(MyTypes::Vec3));
+        if (!path) return false;
+        m.path = {path, size};
+        if (!readWeaponView(m.equipped)) return false;
+        readVec(m.pos);
+        return true;
+    }
+
+    bool readWeaponView(MyTypes::WeaponView &w) {
+        read(w.damage);
+        size_t size{};
+        readSize(size);
+        auto name = readView(size);
+        if (!name) return false;
+        w.name = {reinterpret_cast<const char *>(name), size};
+        return true;
+    }
+
+    //returns pointer to next size bytes in buffer, or nullptr on overflow
+    const uint8_t *readView(size_t size) {
+        if (static_cast<size_t>(std::distance(_pos, _end)) < size)
+            return nullptr;
+        auto res = _pos;
+        _pos += size;
+        return res;
+    }
+
+    //monsters have variable size, so preceding monsters are skipped by reading only their sizes
+    bool seekMonster(Buf buf, size_t index) {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (index >= size)
+            return false;
+        for (size_t i = 0; i < index; ++i) {
+            if (!skipMonster())
+                return false;
+        }
+        return true;
+    }
+
+    //returns false if monster is malformed or truncated
+    bool skipMonster() {
+        size_t size{};
+        if (!skip(sizeof(MyTypes::Monster::hp) + sizeof(MyTypes::Monster::mana)))
+            return false;
+        readSize(size);
+        if (!skip(size) || !skip(sizeof(MyTypes::Color)))
+            return false;
+        readSize(size);
+        if (!skip(size))
+            return false;
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        for (size_t i = 0; i < size; ++i) {
+            if (!skipWeapon())
+                return false;
+        }
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        if (!skip(size * 3 * sizeof(float)) || !skipWeapon())
+            return false;
+        //failed size read leaves less than sizeof(size_t) bytes, so this skip fails after it too
+        return skip(3 * sizeof(float));
+    }
+
+    bool skipWeapon() {
+        size_t size{};
+        if (!skip(sizeof(MyTypes::Weapon::damage)))
+            return false;
+        readSize(size);
+        return skip(size);
+    }
+
+    template<bool Gather>
     void writeWeapon(const MyTypes::Weapon &w) {
         write(w.damage);
         writeSize(w.name.size());
-        write(w.name.data(), w.name.size());
+        writeBytes<Gather>(w.name.data(), w.name.size());
     }
 
     void writeVec(const MyTypes::Vec3 &p) {
@@ -113,11 +349,12 @@ private:
         write(p.z);
     }
 
-    void readWeapon(MyTypes::Weapon &w) {
+    template<typename Weapon>
+    void readWeapon(Weapon &w) {
         read(w.damage);
         size_t size;
         readSize(size);
-        if (size > 100) return;
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return;
         w.name.resize(size);
         read(const_cast<char *>(w.name.data()), size);
     }
@@ -149,12 +386,22 @@ private:
     void read(T *v, size_t count) {
         //check for overflow
         const auto size = count * sizeof(T);
-        if (std::distance(_pos, _end) >= size) {
+        if (static_cast<size_t>(std::distance(_pos, _end)) >= size) {
             std::memcpy(v, _pos, size);
             _pos += size;
         }
     }
 
+    //returns false on overflow and moves to the end, so that following reads fail
+    bool skip(size_t size) {
+        if (static_cast<size_t>(std::distance(_pos, _end)) >= size) {
+            _pos += size;
+            return true;
+        }
+        _pos = _end;
+        return false;
+    }
+
     void readSize(size_t &size) {
         read(size);
     }
@@ -199,12 +446,15 @@ private:
 
     uint8_t *_pos{};
     uint8_t *_end{};
+    //gather mode state: output segments, and beginning of bytes in _buf that are not added yet
+    std::vector<Buf> *_segments{};
+    uint8_t *_segmentBegin{};
     std::array<uint8_t, 1000000> _buf{};
 };
 
 
 int main() {
     HandWrittenTest test{};
-    runTest(test);
+    runTest(test, makeTestFactory<HandWrittenTest>());
     return 0;
 }
@@ -0,0 +1,271 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include <testing/test.h>
+#include <array>
+#include <cstring>
+
+//monsters are written as columns: count, then every field of all monsters one after another.
+//variable size fields are written as column of end offsets (uint32_t, relative to column start), then data.
+//weapons are flattened into one list, with weapons end offsets per monster.
+//decoding validates every offsets column with branch-free loop, then copies columns with plain loops
+class HandWrittenColumnarTest : public ISerializerTest {
+public:
+
+    Buf serialize(const std::vector<MyTypes::Monster> &data) override {
+        auto begin = std::addressof(*_buf.begin());
+        _pos = begin;
+        writeMonsters(data);
+        return {begin, static_cast<size_t >(std::distance(begin, _pos))};
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeRangeInto(data, sink);
+    }
+
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        //writing is unchecked, so make sure upfront that the result fits; uint32_t offsets are never longer
+        if (MyTypes::serializedSizeUpperBound(range) > sink.capacity)
+            return 0;
+        _pos = sink.ptr;
+        writeMonsters(range);
+        return static_cast<size_t>(std::distance(sink.ptr, _pos));
+    }
+
+    void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
+        _in = buf.ptr;
+        _end = buf.ptr + buf.bytesCount;
+        uint32_t count{};
+        if (!read(count) || count > 1000000)
+            return;
+        res.resize(count);
+        const auto hp = column<int16_t>(count);
+        const auto mana = column<int16_t>(count);
+        const auto color = column<uint8_t>(count);
+        const auto pos = column<MyTypes::Vec3>(count);
+        if (!hp || !mana || !color || !pos)
+            return;
+        for (size_t i = 0; i < count; ++i)
+            res[i].hp = load<int16_t>(hp, i);
+        for (size_t i = 0; i < count; ++i)
+            res[i].mana = load<int16_t>(mana, i);
+        for (size_t i = 0; i < count; ++i)
+            res[i].color = static_cast<MyTypes::Color>(color[i]);
+        for (size_t i = 0; i < count; ++i)
+            res[i].pos = load<MyTypes::Vec3>(pos, i);
+
+        if (!readVariable(res, [](MyTypes::Monster &m) -> auto & { return m.name; }) ||
+            !readVariable(res, [](MyTypes::Monster &m) -> auto & { return m.inventory; }) ||
+            !readVariable(res, [](MyTypes::Monster &m) -> auto & { return m.path; }))
+            return;
+        const auto damage = column<int16_t>(count);
+        if (!damage)
+            return;
+        for (size_t i = 0; i < count; ++i)
+            res[i].equipped.damage = load<int16_t>(damage, i);
+        if (!readVariable(res, [](MyTypes::Monster &m) -> auto & { return m.equipped.name; }))
+            return;
+
+        const auto weaponEnds = offsets(count);
+        if (!weaponEnds)
+            return;
+        const size_t weapons = count ? load<uint32_t>(weaponEnds, count - 1) : 0;
+        const auto weaponDamage = column<int16_t>(weapons);
+        const auto nameEnds = offsets(weapons);
+        if (!weaponDamage || !nameEnds)
+            return;
+        const size_t nameBytes = weapons ? load<uint32_t>(nameEnds, weapons - 1) : 0;
+        const auto names = column<char>(nameBytes);
+        if (!names)
+            return;
+        size_t w = 0;
+        for (auto &m:res) {
+            m.weapons.resize(load<uint32_t>(weaponEnds, static_cast<size_t>(&m - res.data())) - w);
+            for (auto &weapon:m.weapons) {
+                const size_t nameBegin = w ? load<uint32_t>(nameEnds, w - 1) : 0;
+                weapon.damage = load<int16_t>(weaponDamage, w);
+                weapon.name.assign(reinterpret_cast<const char *>(names) + nameBegin, load<uint32_t>(nameEnds, w) - nameBegin);
+                ++w;
+            }
+        }
+    }
+
+    TestInfo testInfo() const override {
+        return {
+                SerializationLibrary::HAND_WRITTEN,
+                "columnar",
+                "fields of all monsters are written as separate columns, sizes as uint32_t end offsets"
+        };
+    }
+
+    size_t bufferCapacity() const override {
+        return _buf.size();
+    }
+
+private:
+
+    static_assert(sizeof(MyTypes::Vec3) == 3 * sizeof(float), "path is copied as array of floats");
+
+    void writeMonsters(std::span<const MyTypes::Monster> data) {
+        write(static_cast<uint32_t>(data.size()));
+        for (auto &m:data)
+            write(m.hp);
+        for (auto &m:data)
+            write(m.mana);
+        for (auto &m:data)
+            write(static_cast<const typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+        for (auto &m:data)
+            write(m.pos);
+        writeVariable(data, [](const MyTypes::Monster &m) -> auto & { return m.name; });
+        writeVariable(data, [](const MyTypes::Monster &m) -> auto & { return m.inventory; });
+        writeVariable(data, [](const MyTypes::Monster &m) -> auto & { return m.path; });
+        for (auto &m:data)
+            write(m.equipped.damage);
+        writeVariable(data, [](const MyTypes::Monster &m) -> auto & { return m.equipped.name; });
+
+        //weapons are written as columns too, so their names are in one block
+        writeOffsets(data, [](const MyTypes::Monster &m) { return m.weapons.size(); });
+        for (auto &m:data) {
+            for (auto &w:m.weapons)
+                write(w.damage);
+        }
+        uint32_t end{};
+        for (auto &m:data) {
+            for (auto &w:m.weapons) {
+                end += static_cast<uint32_t>(w.name.size());
+                write(end);
+            }
+        }
+        for (auto &m:data) {
+            for (auto &w:m.weapons)
+                write(w.name.data(), w.name.size());
+        }
+    }
+
+    template<typename Monsters, typename Field>
+    void writeOffsets(const Monsters &data, Field &&size) {
+        uint32_t end{};
+        for (auto &m:data) {
+            end += static_cast<uint32_t>(size(m));
+            write(end);
+        }
+    }
+
+    //offsets column, then all elements of field
+    template<typename Field>
+    void writeVariable(std::span<const MyTypes::Monster> data, Field &&field) {
+        writeOffsets(data, [&](const MyTypes::Monster &m) { return field(m).size(); });
+        for (auto &m:data) {
+            auto &f = field(m);
+            write(f.data(), f.size());
+        }
+    }
+
+    template<typename Field>
+    bool readVariable(std::vector<MyTypes::Monster> &res, Field &&field) {
+        const auto ends = offsets(res.size());
+        if (!ends)
+            return false;
+        using T = typename std::remove_reference_t<decltype(field(res[0]))>::value_type;
+        const auto elements = res.empty() ? 0 : load<uint32_t>(ends, res.size() - 1);
+        const auto values = column<T>(elements);
+        if (!values)
+            return false;
+        uint32_t begin{};
+        for (size_t i = 0; i < res.size(); ++i) {
+            const auto end = load<uint32_t>(ends, i);
+            auto &f = field(res[i]);
+            f.resize(end - begin);
+            //empty containers might have null data, which memcpy doesn't allow
+            if (end != begin)
+                std::memcpy(f.data(), values + begin * sizeof(T), (end - begin) * sizeof(T));
+            begin = end;
+        }
+        return true;
+    }
+
+    //offsets column of count elements, each element at most MAX_CONTAINER_SIZE bigger than previous
+    const uint8_t *offsets(size_t count) {
+        const auto ends = column<uint32_t>(count);
+        if (!ends || count == 0)
+            return ends;
+        //branch-free, so that compiler can vectorize it
+        uint32_t bad = load<uint32_t>(ends, 0) > MyTypes::MAX_CONTAINER_SIZE;
+        for (size_t i = 1; i < count; ++i) {
+            const auto prev = load<uint32_t>(ends, i - 1);
+            const auto cur = load<uint32_t>(ends, i);
+            bad |= (cur < prev) | (cur - prev > MyTypes::MAX_CONTAINER_SIZE);
+        }
+        return bad ? nullptr : ends;
+    }
+
+    //returns beginning of column of count elements, or nullptr if buffer is too short
+    template<typename T>
+    const uint8_t *column(size_t count) {
+        const auto size = count * sizeof(T);
+        if (static_cast<size_t>(std::distance(_in, _end)) < size)
+            return nullptr;
+        const auto res = _in;
+        _in += size;
+        return res;
+    }
+
+    //columns are not aligned
+    template<typename T>
+    static T load(const uint8_t *column, size_t index) {
+        T v;
+        std::memcpy(&v, column + index * sizeof(T), sizeof(T));
+        return v;
+    }
+
+    template<typename T>
+    bool read(T &v) {
+        const auto c = column<T>(1);
+        if (!c)
+            return false;
+        v = load<T>(c, 0);
+        return true;
+    }
+
+    template<typename T>
+    void write(const T &v) {
+        write(&v, 1);
+    }
+
+    template<typename T>
+    void write(const T *v, size_t count) {
+        const auto size = count * sizeof(T);
+        if (size != 0)
+            std::memcpy(_pos, v, size);
+        _pos += size;
+    }
+
+    uint8_t *_pos{};
+    const uint8_t *_in{};
+    const uint8_t *_end{};
+    std::array<uint8_t, 1000000> _buf{};
+};
+
+int main() {
+    HandWrittenColumnarTest test{};
+    return runTest(test, makeTestFactory<HandWrittenColumnarTest>());
+}
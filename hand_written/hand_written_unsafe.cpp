@@ -30,6 +30,93 @@ public:
     Buf serialize(const std::vector<MyTypes::Monster> &data) override {
         auto begin = std::addressof(*_buf.begin());
         _pos = begin;
+        writeMonsters(data);
+        return {begin, static_cast<size_t >(std::distance(begin, _pos))};
+    }
+
+    void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size;
+        readSize(size);
+        if (size > 1000000)
+            return;
+        res.resize(size);
+        for (auto &m:res) {
+            if (!decodeMonster(m))
+                return;
+        }
+    }
+
+    bool deserializeRange(Buf buf, std::span<MyTypes::Monster> res) override {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (size != res.size())
+            return false;
+        for (auto &m:res) {
+            if (!decodeMonster(m))
+                return false;
+        }
+        return true;
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeRangeInto(data, sink);
+    }
+
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        //writing is unchecked, so make sure upfront that the result fits
+        if (MyTypes::serializedSizeUpperBound(range) > sink.capacity)
+            return 0;
+        _pos = sink.ptr;
+        writeMonsters(range);
+        return static_cast<size_t>(std::distance(sink.ptr, _pos));
+    }
+
+    bool hasDirectAccess() const override {
+        return true;
+    }
+
+    int16_t readHp(Buf buf, size_t index) override {
+        int16_t hp{};
+        //hp is first field of monster
+        if (seekMonster(buf, index))
+            read(hp);
+        return hp;
+    }
+
+    MyTypes::Vec3 readPos(Buf buf, size_t index) override {
+        MyTypes::Vec3 pos{};
+        //pos is last field of monster
+        if (seekMonster(buf, index) && skipMonster()) {
+            _pos -= 3 * sizeof(float);
+            readVec(pos);
+        }
+        return pos;
+    }
+
+    void readMonster(Buf buf, size_t index, MyTypes::Monster &res) override {
+        if (seekMonster(buf, index))
+            decodeMonster(res);
+    }
+
+    TestInfo testInfo() const override {
+        return {
+                SerializationLibrary::HAND_WRITTEN,
+                "unsafe",
+                "doesn't check for buffer size when reading, buffer: std::array<uint8_t, 1000000>"
+        };
+    }
+
+    size_t bufferCapacity() const override {
+        return _buf.size();
+    }
+
+private:
+
+    void writeMonsters(std::span<const MyTypes::Monster> data) {
         writeSize(data.size());
         for (auto &m:data) {
             write(m.hp);
@@ -50,56 +137,79 @@ public:
             writeWeapon(m.equipped);
             writeVec(m.pos);
         }
-        return {begin, static_cast<size_t >(std::distance(begin, _pos))};
     }
 
-    void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        _pos = const_cast<uint8_t *>(buf.ptr);
-        _end = std::next(_pos, buf.bytesCount);
+    bool decodeMonster(MyTypes::Monster &m) {
         size_t size;
+        read(m.hp);
+        read(m.mana);
         readSize(size);
-        if (size > 1000000)
-            return;
-        res.resize(size);
-        for (auto &m:res) {
-            read(m.hp);
-            read(m.mana);
-            readSize(size);
-            if (size > 100) return;
-            m.name.resize(size);
-            read(const_cast<char *>(m.name.data()), size);
-            read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color));
-            readSize(size);
-            if (size > 100) return;
-            m.inventory.resize(size);
-            read(m.inventory.data(), size);
-            readSize(size);
-            if (size > 100) return;
-            m.weapons.resize(size);
-            for (auto &w:m.weapons) {
-                readWeapon(w);
-            }
-            readSize(size);
-            if (size > 100) return;
-            m.path.resize(size);
-            for (auto &p:m.path) {
-                readVec(p);
-            }
-            readWeapon(m.equipped);
-            readVec(m.pos);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.name.resize(size);
+        read(const_cast<char *>(m.name.data()), size);
+        read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.inventory.resize(size);
+        read(m.inventory.data(), size);
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.weapons.resize(size);
+        for (auto &w:m.weapons) {
+            readWeapon(w);
         }
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        m.path.resize(size);
+        for (auto &p:m.path) {
+            readVec(p);
+        }
+        readWeapon(m.equipped);
+        readVec(m.pos);
+        return true;
+    }
 
+    //monsters have variable size, so preceding monsters are skipped by reading only their sizes
+    bool seekMonster(Buf buf, size_t index) {
+        _pos = const_cast<uint8_t *>(buf.ptr);
+        _end = std::next(_pos, buf.bytesCount);
+        size_t size{};
+        readSize(size);
+        if (index >= size)
+            return false;
+        for (size_t i = 0; i < index; ++i) {
+            if (!skipMonster())
+                return false;
+        }
+        return true;
     }
 
-    TestInfo testInfo() const override {
-        return {
-                SerializationLibrary::HAND_WRITTEN,
-                "unsafe",
-                "doesn't check for buffer size when reading, buffer: std::array<uint8_t, 1000000>"
-        };
+    bool skipMonster() {
+        size_t size{};
+        skip(sizeof(MyTypes::Monster::hp) + sizeof(MyTypes::Monster::mana));
+        readSize(size);
+        skip(size);
+        skip(sizeof(MyTypes::Color));
+        readSize(size);
+        skip(size);
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        for (size_t i = 0; i < size; ++i)
+            skipWeapon();
+        readSize(size);
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return false;
+        skip(size * 3 * sizeof(float));
+        skipWeapon();
+        skip(3 * sizeof(float));
+        return true;
     }
 
-private:
+    void skipWeapon() {
+        size_t size{};
+        skip(sizeof(MyTypes::Weapon::damage));
+        readSize(size);
+        skip(size);
+    }
 
     void writeWeapon(const MyTypes::Weapon &w) {
         write(w.damage);
@@ -117,7 +227,7 @@ private:
         read(w.damage);
         size_t size;
         readSize(size);
-        if (size > 100) return;
+        if (size > MyTypes::MAX_CONTAINER_SIZE) return;
         w.name.resize(size);
         read(const_cast<char *>(w.name.data()), size);
     }
@@ -153,6 +263,11 @@ private:
         _pos += size;
     }
 
+    void skip(size_t size) {
+        //do not check for overflow
+        _pos += size;
+    }
+
     void readSize(size_t &size) {
         read(size);
     }
@@ -169,5 +284,5 @@ private:
 
 int main() {
     HandWrittenTest test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<HandWrittenTest>());
 }
@@ -0,0 +1,321 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_HAND_WRITTEN_VARINT_H
+#define CPP_SERIALIZERS_BENCHMARK_HAND_WRITTEN_VARINT_H
+
+#include <testing/test.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAND_WRITTEN_VARINT_X86
+#include <immintrin.h>
+#endif
+
+//sizes are LEB128 varints: 7 bits per byte, least significant first, high bit set on all bytes but last.
+//all sizes of a monster are written as one run before its data, so that decoder can process them in bulk:
+//weapons count, then name, inventory, path and equipped name sizes, then name size of every weapon
+namespace varint {
+
+    //bytes that run decoders might read and write past the end of run
+    constexpr size_t RUN_PADDING = 32;
+
+    //sizes never exceed uint32_t, so varint is at most 5 bytes
+    inline const uint8_t *readVarint(const uint8_t *pos, const uint8_t *end, uint32_t &v) {
+        uint32_t res{};
+        for (unsigned shift = 0; shift < 35; shift += 7) {
+            if (pos == end)
+                return nullptr;
+            const uint32_t b = *pos++;
+            if (shift == 28 && b > 0x0Fu)
+                return nullptr;
+            res |= (b & 0x7Fu) << shift;
+            if (b < 0x80u) {
+                v = res;
+                return pos;
+            }
+        }
+        return nullptr;
+    }
+
+    //decodes count varints into out, returns position after them or nullptr on error
+    inline const uint8_t *decodeRunScalar(const uint8_t *pos, const uint8_t *end, uint32_t *out, size_t count) {
+        for (size_t i = 0; pos && i < count; ++i)
+            pos = readVarint(pos, end, out[i]);
+        return pos;
+    }
+
+#ifdef HAND_WRITTEN_VARINT_X86
+
+    //classify 16 bytes at once: leading bytes without continuation bit are complete single byte varints,
+    //all 16 are widened and stored, but only those are kept. multi byte varint that follows is decoded by scalar.
+    //out must have RUN_PADDING extra elements
+    inline const uint8_t *decodeRunSse2(const uint8_t *pos, const uint8_t *end, uint32_t *out, size_t count) {
+        const auto zero = _mm_setzero_si128();
+        while (count > 0 && end - pos >= 16) {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(bytes));
+            const auto lo = _mm_unpacklo_epi8(bytes, zero);
+            const auto hi = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(hi, zero));
+            const size_t single = mask ? static_cast<size_t>(__builtin_ctz(mask)) : 16;
+            const auto n = std::min(single, count);
+            pos += n;
+            out += n;
+            count -= n;
+            if (count > 0 && single < 16) {
+                pos = readVarint(pos, end, *out);
+                if (!pos)
+                    return nullptr;
+                ++out;
+                --count;
+            }
+        }
+        return decodeRunScalar(pos, end, out, count);
+    }
+
+    //same as SSE2 version, but 32 bytes at once
+    __attribute__((target("avx2")))
+    inline const uint8_t *decodeRunAvx2(const uint8_t *pos, const uint8_t *end, uint32_t *out, size_t count) {
+        while (count > 0 && end - pos >= 32) {
+            const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(bytes));
+            for (size_t i = 0; i < 4; ++i) {
+                const auto part = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pos + 8 * i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 8 * i), _mm256_cvtepu8_epi32(part));
+            }
+            const size_t single = mask ? static_cast<size_t>(__builtin_ctz(mask)) : 32;
+            const auto n = std::min(single, count);
+            pos += n;
+            out += n;
+            count -= n;
+            if (count > 0 && single < 32) {
+                pos = readVarint(pos, end, *out);
+                if (!pos)
+                    return nullptr;
+                ++out;
+                --count;
+            }
+        }
+        return decodeRunSse2(pos, end, out, count);
+    }
+
+#endif
+
+    using RunDecoder = const uint8_t *(*)(const uint8_t *, const uint8_t *, uint32_t *, size_t);
+
+    //best decoder that current cpu supports, and its name
+    inline std::pair<RunDecoder, const char *> selectRunDecoder() {
+#ifdef HAND_WRITTEN_VARINT_X86
+        if (__builtin_cpu_supports("avx2"))
+            return {decodeRunAvx2, "AVX2"};
+        return {decodeRunSse2, "SSE2"};
+#else
+        return {decodeRunScalar, "scalar"};
+#endif
+    }
+
+}
+
+//Simd selects bulk decoding of size runs with best instruction set available at runtime
+template<bool Simd>
+class HandWrittenVarintTest : public ISerializerTest {
+public:
+
+    HandWrittenVarintTest() {
+        if (Simd)
+            std::tie(_decodeRun, _decoderName) = varint::selectRunDecoder();
+    }
+
+    Buf serialize(const std::vector<MyTypes::Monster> &data) override {
+        auto begin = std::addressof(*_buf.begin());
+        _pos = begin;
+        writeMonsters(data);
+        return {begin, static_cast<size_t >(std::distance(begin, _pos))};
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        return serializeRangeInto(data, sink);
+    }
+
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        //writing is unchecked, so make sure upfront that the result fits; varint sizes are never longer
+        if (MyTypes::serializedSizeUpperBound(range) > sink.capacity)
+            return 0;
+        _pos = sink.ptr;
+        writeMonsters(range);
+        return static_cast<size_t>(std::distance(sink.ptr, _pos));
+    }
+
+    void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
+        _in = buf.ptr;
+        _end = buf.ptr + buf.bytesCount;
+        uint32_t size{};
+        _in = varint::readVarint(_in, _end, size);
+        if (!_in || size > 1000000)
+            return;
+        res.resize(size);
+        for (auto &m:res) {
+            if (!decodeMonster(m))
+                return;
+        }
+    }
+
+    TestInfo testInfo() const override {
+        return {
+                SerializationLibrary::HAND_WRITTEN,
+                Simd ? "varint simd" : "varint",
+                Simd ? std::string{"LEB128 sizes grouped before monster data, decoded in bulk with "} + _decoderName
+                     : "LEB128 sizes grouped before monster data, decoded one by one"
+        };
+    }
+
+    size_t bufferCapacity() const override {
+        return _buf.size();
+    }
+
+private:
+
+    static_assert(sizeof(MyTypes::Vec3) == 3 * sizeof(float), "path is copied as array of floats");
+
+    //number of sizes in a run before weapon names
+    static constexpr size_t FIXED_SIZES = 4;
+
+    bool decodeMonster(MyTypes::Monster &m) {
+        if (!read(m.hp) || !read(m.mana) ||
+            !read(reinterpret_cast<typename std::underlying_type<MyTypes::Color>::type &>(m.color)) ||
+            !read(m.pos))
+            return false;
+        uint32_t weapons{};
+        _in = varint::readVarint(_in, _end, weapons);
+        if (!_in || weapons > MyTypes::MAX_CONTAINER_SIZE)
+            return false;
+        const auto count = FIXED_SIZES + weapons;
+        _in = _decodeRun(_in, _end, _sizes.data(), count);
+        if (!_in)
+            return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (_sizes[i] > MyTypes::MAX_CONTAINER_SIZE)
+                return false;
+        }
+        m.name.resize(_sizes[0]);
+        m.inventory.resize(_sizes[1]);
+        m.path.resize(_sizes[2]);
+        m.equipped.name.resize(_sizes[3]);
+        m.weapons.resize(weapons);
+        if (!read(m.name.data(), m.name.size()) || !read(m.inventory.data(), m.inventory.size()) ||
+            !read(m.path.data(), m.path.size()) || !read(m.equipped.damage) ||
+            !read(m.equipped.name.data(), m.equipped.name.size()))
+            return false;
+        for (size_t i = 0; i < weapons; ++i) {
+            auto &w = m.weapons[i];
+            w.name.resize(_sizes[FIXED_SIZES + i]);
+            if (!read(w.damage) || !read(w.name.data(), w.name.size()))
+                return false;
+        }
+        return true;
+    }
+
+    void writeMonsters(std::span<const MyTypes::Monster> data) {
+        writeVarint(data.size());
+        for (auto &m:data) {
+            write(m.hp);
+            write(m.mana);
+            write(static_cast<const typename std::underlying_type<MyTypes::Color>::type &>(m.color));
+            write(m.pos);
+            writeVarint(m.weapons.size());
+            writeVarint(m.name.size());
+            writeVarint(m.inventory.size());
+            writeVarint(m.path.size());
+            writeVarint(m.equipped.name.size());
+            for (auto &w:m.weapons)
+                writeVarint(w.name.size());
+            write(m.name.data(), m.name.size());
+            write(m.inventory.data(), m.inventory.size());
+            write(m.path.data(), m.path.size());
+            writeWeapon(m.equipped);
+            for (auto &w:m.weapons)
+                writeWeapon(w);
+        }
+    }
+
+    void writeWeapon(const MyTypes::Weapon &w) {
+        write(w.damage);
+        write(w.name.data(), w.name.size());
+    }
+
+    void writeVarint(size_t v) {
+        while (v >= 0x80u) {
+            *_pos++ = static_cast<uint8_t>(v | 0x80u);
+            v >>= 7;
+        }
+        *_pos++ = static_cast<uint8_t>(v);
+    }
+
+    template<typename T>
+    void write(const T &v) {
+        write(&v, 1);
+    }
+
+    template<typename T>
+    void write(const T *v, size_t count) {
+        const auto size = count * sizeof(T);
+        //empty containers might have null data, which memcpy doesn't allow
+        if (size != 0)
+            std::memcpy(_pos, v, size);
+        _pos += size;
+    }
+
+    template<typename T>
+    bool read(T &v) {
+        return read(&v, 1);
+    }
+
+    template<typename T>
+    bool read(T *v, size_t count) {
+        const auto size = count * sizeof(T);
+        if (static_cast<size_t>(std::distance(_in, _end)) < size)
+            return false;
+        if (size != 0)
+            std::memcpy(v, _in, size);
+        _in += size;
+        return true;
+    }
+
+    varint::RunDecoder _decodeRun{varint::decodeRunScalar};
+    const char *_decoderName{"scalar"};
+    //sizes of current monster, room for most weapons and decoder padding
+    std::array<uint32_t, MyTypes::MAX_CONTAINER_SIZE + FIXED_SIZES + varint::RUN_PADDING> _sizes{};
+    uint8_t *_pos{};
+    const uint8_t *_in{};
+    const uint8_t *_end{};
+    std::array<uint8_t, 1000000> _buf{};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_HAND_WRITTEN_VARINT_H
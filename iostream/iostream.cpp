@@ -21,6 +21,7 @@
 //SOFTWARE.
 
 #include <testing/test.h>
+#include <testing/memory_stream.h>
 #include <iostream>
 #include <sstream>
 
@@ -143,10 +144,8 @@ public:
     using namespace iostream_ops;
     std::ostringstream os;
     write(os, data);
-    //copy only once to permanent buffer
-    if (_buf.empty()) {
-      _buf = os.str();
-    }
+    //move out stream's string, so result is always up to date without extra copy
+    _buf = std::move(os).str();
 
     return {
             reinterpret_cast<uint8_t *>(std::addressof(*_buf.begin())),
@@ -154,9 +153,17 @@ public:
     };
   }
 
+  size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+    using namespace iostream_ops;
+    MemoryStreamBuf sb{sink};
+    std::ostream os{&sb};
+    write(os, data);
+    return sb.overflowed() ? 0 : sb.written();
+  }
+
   void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
     using namespace iostream_ops;
-    std::istringstream is(_buf);
+    std::istringstream is(std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount});
     read(is, resVec);
   }
 
@@ -175,5 +182,5 @@ private:
 
 int main() {
     IoStreams test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<IoStreams>());
 }
@@ -117,6 +117,22 @@ struct convert<MyTypes::Monster> {
 }
 }
 
+//packer stream that writes into OutputSink, stops writing when sink is full
+struct SinkWriter {
+    OutputSink sink;
+    size_t written{};
+    bool overflowed{};
+
+    void write(const char* data, size_t size) {
+        if (overflowed || size > sink.capacity - written) {
+            overflowed = true;
+            return;
+        }
+        std::memcpy(sink.ptr + written, data, size);
+        written += size;
+    }
+};
+
 class msgpackArchiver : public ISerializerTest {
 public:
 
@@ -127,8 +143,14 @@ public:
         return Buf{reinterpret_cast<uint8_t *>(_buf.data()), _buf.size()};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        SinkWriter writer{sink};
+        msgpack::pack(writer, data);
+        return writer.overflowed ? 0 : writer.written;
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
-        msgpack::object_handle oh = msgpack::unpack(_buf.data(), _buf.size());
+        msgpack::object_handle oh = msgpack::unpack(reinterpret_cast<const char *>(buf.ptr), buf.bytesCount);
         msgpack::object obj = oh.get();
         obj.convert(res);
     }
@@ -147,5 +169,5 @@ private:
 
 int main() {
     msgpackArchiver test{};
-    return runTest(test);
+    return runTest(test, makeTestFactory<msgpackArchiver>());
 }
@@ -40,10 +40,24 @@ public:
         };
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        Arena arena;
+        auto res = Arena::CreateMessage<Monsters>(&arena);
+        auto monsters = res->mutable_monsters();
+        for (const auto& m: data) {
+            serializeMonster(monsters->Add(), m);
+        }
+        auto size = res->ByteSizeLong();
+        if (size > sink.capacity || size > static_cast<size_t>(std::numeric_limits<int>::max()))
+            return 0;
+        res->SerializeWithCachedSizesToArray(sink.ptr);
+        return size;
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &res) override {
         Arena arena;
         auto des = Arena::CreateMessage<Monsters>(&arena);
-        des->ParseFromString(_buf);
+        des->ParseFromArray(buf.ptr, static_cast<int>(buf.bytesCount));
         res.resize(des->monsters().size());
         auto beginDesM = des->monsters().begin();
         for (auto& m: res) {
@@ -67,7 +81,7 @@ private:
 int main() {
     GOOGLE_PROTOBUF_VERIFY_VERSION;
     ProtobufArchiver test;
-    auto res = runTest(test);
+    auto res = runTest(test, makeTestFactory<ProtobufArchiver>());
     google::protobuf::ShutdownProtobufLibrary();
     return res;
 }
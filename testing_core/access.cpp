@@ -0,0 +1,79 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+    //returns average nanoseconds per call, or -1 if some result was wrong
+    template<typename Op>
+    double measureAccess(const std::vector<size_t>& indices, Op&& op) {
+        bool valid = true;
+        const auto start = BenchClock::now();
+        for (auto i: indices)
+            valid &= op(i);
+        const auto ns = static_cast<double>(elapsedNs(start, BenchClock::now()));
+        return valid ? ns / static_cast<double>(indices.size()) : -1.0;
+    }
+
+}
+
+void runAccessBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                        size_t samples) {
+    if (data.empty())
+        return;
+    //serialization might return internal buffer that is overwritten, keep own copy
+    std::vector<uint8_t> input(buf.ptr, buf.ptr + buf.bytesCount);
+    buf = Buf{input.data(), input.size()};
+
+    //same random indices for every test
+    std::mt19937 rng{data.size()};
+    std::uniform_int_distribution<size_t> dist{0, data.size() - 1};
+    std::vector<size_t> indices(samples);
+    for (auto& i: indices)
+        i = dist(rng);
+
+    MyTypes::Monster monster{};
+    const std::pair<const char*, double> results[] = {
+        {"hp", measureAccess(indices, [&](size_t i) { return testCase.readHp(buf, i) == data[i].hp; })},
+        {"pos", measureAccess(indices, [&](size_t i) { return testCase.readPos(buf, i) == data[i].pos; })},
+        {"monster", measureAccess(indices, [&](size_t i) {
+            testCase.readMonster(buf, i, monster);
+            return monster == data[i];
+        })},
+    };
+
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* access (" << (testCase.hasDirectAccess() ? "direct" : "full decode")
+         << "):";
+    for (auto [name, ns]: results) {
+        line << " " << name << " ";
+        if (ns < 0)
+            line << "result != data";
+        else
+            line << ns << " ns";
+    }
+    std::cout << line.str() << std::endl;
+}
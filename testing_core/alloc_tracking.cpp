@@ -0,0 +1,246 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "alloc_tracking.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+    std::atomic<bool> tracking{false};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> bytes{0};
+
+}
+
+#if defined(ALLOC_TRACKING_ENABLED)
+
+namespace {
+
+    inline void onAlloc(void* ptr, size_t size) {
+        if (ptr != nullptr && tracking.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+
+    inline void onFree(void* ptr) {
+        if (ptr != nullptr && tracking.load(std::memory_order_relaxed))
+            frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
+
+#if defined(__GLIBC__)
+
+//glibc exports its allocator under these names, so malloc family can be replaced and still forward to it
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+
+    void* malloc(size_t size) {
+        auto ptr = __libc_malloc(size);
+        onAlloc(ptr, size);
+        return ptr;
+    }
+
+    void* calloc(size_t count, size_t size) {
+        auto ptr = __libc_calloc(count, size);
+        onAlloc(ptr, count * size);
+        return ptr;
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        auto res = __libc_realloc(ptr, size);
+        if (ptr != nullptr && (res != nullptr || size == 0))
+            onFree(ptr);
+        onAlloc(res, size);
+        return res;
+    }
+
+    void* memalign(size_t alignment, size_t size) {
+        auto ptr = __libc_memalign(alignment, size);
+        onAlloc(ptr, size);
+        return ptr;
+    }
+
+    //same alignment validation as glibc, memalign itself rounds invalid alignment up instead of failing
+    void* aligned_alloc(size_t alignment, size_t size) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            errno = EINVAL;
+            return nullptr;
+        }
+        return memalign(alignment, size);
+    }
+
+    int posix_memalign(void** res, size_t alignment, size_t size) {
+        const auto words = alignment / sizeof(void*);
+        if (alignment % sizeof(void*) != 0 || words == 0 || (words & (words - 1)) != 0)
+            return EINVAL;
+        auto ptr = memalign(alignment, size);
+        if (ptr == nullptr)
+            return ENOMEM;
+        *res = ptr;
+        return 0;
+    }
+
+    void free(void* ptr) {
+        onFree(ptr);
+        __libc_free(ptr);
+    }
+}
+
+namespace {
+
+    inline void* rawAlloc(size_t size) {
+        return __libc_malloc(size);
+    }
+
+    inline void* rawAlignedAlloc(size_t alignment, size_t size) {
+        return __libc_memalign(alignment, size);
+    }
+
+    inline void rawFree(void* ptr) {
+        __libc_free(ptr);
+    }
+
+}
+
+#else
+
+namespace {
+
+    inline void* rawAlloc(size_t size) {
+        return std::malloc(size);
+    }
+
+    inline void* rawAlignedAlloc(size_t alignment, size_t size) {
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    inline void rawFree(void* ptr) {
+        std::free(ptr);
+    }
+
+}
+
+#endif
+
+namespace {
+
+    void* trackedNew(size_t size) {
+        if (size == 0)
+            size = 1;
+        while (true) {
+            if (auto ptr = rawAlloc(size)) {
+                onAlloc(ptr, size);
+                return ptr;
+            }
+            auto handler = std::get_new_handler();
+            if (handler == nullptr)
+                throw std::bad_alloc{};
+            handler();
+        }
+    }
+
+    void* trackedNew(size_t size, std::align_val_t alignment) {
+        if (size == 0)
+            size = 1;
+        while (true) {
+            if (auto ptr = rawAlignedAlloc(static_cast<size_t>(alignment), size)) {
+                onAlloc(ptr, size);
+                return ptr;
+            }
+            auto handler = std::get_new_handler();
+            if (handler == nullptr)
+                throw std::bad_alloc{};
+            handler();
+        }
+    }
+
+    template<typename... Args>
+    void* trackedNewNoThrow(size_t size, Args... args) noexcept {
+        try {
+            return trackedNew(size, args...);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    void trackedDelete(void* ptr) noexcept {
+        onFree(ptr);
+        rawFree(ptr);
+    }
+
+}
+
+void* operator new(size_t size) { return trackedNew(size); }
+void* operator new[](size_t size) { return trackedNew(size); }
+void* operator new(size_t size, std::align_val_t al) { return trackedNew(size, al); }
+void* operator new[](size_t size, std::align_val_t al) { return trackedNew(size, al); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedNewNoThrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedNewNoThrow(size); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return trackedNewNoThrow(size, al); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return trackedNewNoThrow(size, al); }
+
+void operator delete(void* ptr) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr) noexcept { trackedDelete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedDelete(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedDelete(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedDelete(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedDelete(ptr); }
+
+bool allocTrackingSupported() {
+    return true;
+}
+
+#else
+
+bool allocTrackingSupported() {
+    return false;
+}
+
+#endif
+
+void startAllocTracking() {
+    allocations = 0;
+    frees = 0;
+    bytes = 0;
+    tracking = true;
+}
+
+AllocStats stopAllocTracking() {
+    tracking = false;
+    return {allocations.load(), frees.load(), bytes.load()};
+}
@@ -0,0 +1,41 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_ALLOC_TRACKING_H
+#define CPP_SERIALIZERS_BENCHMARK_ALLOC_TRACKING_H
+
+#include <cstdint>
+
+struct AllocStats {
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytes;
+};
+
+//global operator new/delete and malloc/free are interposed when built with ALLOC_TRACKING=ON,
+//but they are counted only between startAllocTracking and stopAllocTracking,
+//so timed measurements only pay for one relaxed atomic load per allocation.
+bool allocTrackingSupported();
+void startAllocTracking();
+AllocStats stopAllocTracking();
+
+#endif //CPP_SERIALIZERS_BENCHMARK_ALLOC_TRACKING_H
@@ -0,0 +1,62 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "benchmarks.h"
+#include "alloc_tracking.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    void printAllocStats(const std::string& label, const AllocStats& stats, size_t samples) {
+        const auto calls = static_cast<double>(samples);
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(2) << "* " << label << ": "
+             << static_cast<double>(stats.allocations) / calls << " allocations, "
+             << static_cast<double>(stats.frees) / calls << " frees, "
+             << static_cast<double>(stats.bytes) / calls << " bytes per call";
+        std::cout << line.str() << std::endl;
+    }
+
+}
+
+void runAllocationBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                            size_t samples) {
+    if (!allocTrackingSupported()) {
+        std::cout << "* allocations: unavailable, build with -DALLOC_TRACKING=ON" << std::endl;
+        return;
+    }
+    std::vector<MyTypes::Monster> res{};
+    testCase.deserialize(buf, res);
+
+    startAllocTracking();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.serialize(data);
+    printAllocStats("ser allocations", stopAllocTracking(), samples);
+
+    //deserialize on top of old object, same as default measurement
+    startAllocTracking();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.deserialize(buf, res);
+    printAllocStats("des allocations", stopAllocTracking(), samples);
+}
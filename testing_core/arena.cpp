@@ -0,0 +1,97 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "alloc_tracking.h"
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+
+namespace {
+
+    bool equals(const std::pmr::vector<MyTypes::pmr::Monster>& res, const std::vector<MyTypes::Monster>& data) {
+        return std::equal(res.begin(), res.end(), data.begin(), data.end());
+    }
+
+}
+
+void runArenaBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples) {
+    //serialize result is valid only until next call, so keep own copy
+    const auto serialized = testCase.serialize(data);
+    const std::vector<uint8_t> storage(serialized.ptr, serialized.ptr + serialized.bytesCount);
+    const Buf buf{storage.data(), storage.size()};
+
+    {
+        std::pmr::vector<MyTypes::pmr::Monster> res{};
+        if (!testCase.deserializePmr(buf, res)) {
+            std::cout << "* arena      : not supported" << std::endl;
+            return;
+        }
+        if (!equals(res, data)) {
+            std::cout << "* arena      : result != data, abort." << std::endl;
+            return;
+        }
+    }
+
+    //initial buffer is big enough for whole result, so arena never goes to upstream in steady state
+    std::vector<std::byte> arenaBuffer(std::max<size_t>(1u << 20, 32 * storage.size()));
+    std::pmr::monotonic_buffer_resource arena{arenaBuffer.data(), arenaBuffer.size()};
+
+    //every variant starts from empty result and destroys it, as if each message was decoded into new object
+    auto globalCall = [&]() {
+        std::vector<MyTypes::Monster> res{};
+        testCase.deserialize(buf, res);
+    };
+    auto pmrCall = [&](std::pmr::memory_resource* resource) {
+        std::pmr::vector<MyTypes::pmr::Monster> res{resource};
+        testCase.deserializePmr(buf, res);
+    };
+    auto arenaCall = [&]() {
+        pmrCall(&arena);
+        //deallocate is no-op for monotonic resource, everything is released at once
+        arena.release();
+    };
+
+    auto timeNs = [samples](auto&& call) {
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < samples; ++i)
+            call();
+        return static_cast<double>(elapsedNs(start, BenchClock::now())) / static_cast<double>(samples);
+    };
+    const auto globalNs = timeNs(globalCall);
+    const auto newDeleteNs = timeNs([&]() { pmrCall(std::pmr::new_delete_resource()); });
+    const auto arenaNs = timeNs(arenaCall);
+
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* arena      : global allocator " << globalNs
+         << " ns, pmr new_delete " << newDeleteNs << " ns, monotonic arena " << arenaNs << " ns, speedup "
+         << std::setprecision(2) << globalNs / arenaNs << "x";
+    if (allocTrackingSupported()) {
+        auto allocations = [](auto&& call) {
+            startAllocTracking();
+            call();
+            return stopAllocTracking().allocations;
+        };
+        line << ", allocations " << allocations(globalCall) << " -> " << allocations(arenaCall);
+    }
+    std::cout << line.str() << std::endl;
+}
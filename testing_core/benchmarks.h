@@ -0,0 +1,113 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_BENCHMARKS_H
+#define CPP_SERIALIZERS_BENCHMARK_BENCHMARKS_H
+
+#include <testing/test.h>
+#include <chrono>
+#include <string>
+#include "histogram.h"
+
+//optional measurements that runTest executes after the default serialize/deserialize measurement.
+
+using BenchClock = std::chrono::steady_clock;
+
+inline uint64_t elapsedNs(BenchClock::time_point start, BenchClock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+//median cost of reading the clock twice, it is subtracted from every individually timed call
+uint64_t timerOverheadNs();
+void printLatency(const std::string& label, const LatencyHistogram& hist);
+
+void runLatencyBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                         size_t samples);
+
+void runAllocationBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                            size_t samples);
+
+//read hp, pos and whole monster at random indices directly from buffer, see ISerializerTest::readHp
+void runAccessBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                        size_t samples);
+
+//zero-copy decoding into MyTypes::MonstersView, compared to deserialization on top of old object
+void runViewBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                      size_t samples);
+
+//deserialize on top of old object, into new object and into cleared object for every call
+void runDeserializeModes(ISerializerTest& testCase, Buf buf, size_t samples);
+
+//mode "evict" writes buffer of coldBytes (0 means 2x last level cache) between calls,
+//mode "rotate" uses different data set for every call, so that all of them are about coldBytes
+//(0 means last level cache) serialized, any other mode runs both
+void runColdCacheBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                           MyTypes::WorkloadProfile profile, uint32_t seed, const std::string& mode,
+                           size_t coldBytes, size_t samples);
+
+//monsters count grows 4x starting from 1, until maxMonsters (0 means 2x last level cache),
+//each size is measured for about bytesPerSize serialized bytes, data is generated by generatorThreads (0 all cores)
+void runSizeSweep(ISerializerTest& testCase, MyTypes::WorkloadProfile profile, uint32_t seed,
+                  size_t bytesPerMonster, size_t maxMonsters, size_t bytesPerSize, size_t generatorThreads);
+
+//producer thread serializes data into ring of slots buffers, consumer thread deserializes it,
+//reports messages/s and latency from serialization start to deserialization end. cpu < 0 doesn't pin thread
+void runPipelineBenchmark(const TestFactory& factory, const std::vector<MyTypes::Monster>& data,
+                          size_t messages, size_t slots, long producerCpu, long consumerCpu);
+
+//forked writer process serializes data into shared memory ring, this process deserializes it,
+//reports messages/s, MB/s and latency from serialization start to deserialization end
+void runShmBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages,
+                     size_t slots);
+
+//forked sender process writes length-prefixed serialized data to unix domain or loopback tcp socket,
+//this process reads and deserializes it, reports messages/s, MB/s including frame headers and latency
+void runSocketBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages,
+                        bool tcp);
+
+//serialize and write contiguous buffer to pipe, compared to serializeGather and writev of segments
+void runGatherBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples);
+
+//serialize and copy result to caller's buffer, compared to serializeInto same buffer
+void runSinkBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples);
+
+//serialize and deserialize every monster as separate single element message, reports messages per second
+void runMessageRateBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages);
+
+//messages dominated by Vec3, Weapon or Monster of increasing size, reports fixed per call and per byte cost
+void runTypeMicrobenchmarks(ISerializerTest& testCase, uint32_t seed);
+
+//chunked serialization of big generated list on 1 to maxThreads threads, compared to single thread
+void runChunkedScaling(const TestFactory& factory, MyTypes::WorkloadProfile profile, uint32_t seed,
+                       size_t monsters, size_t chunkMonsters, size_t maxThreads, size_t samples);
+
+//load of chunked snapshot into empty list on 1 to maxThreads threads, compared to sequential deserialize
+void runChunkedLoad(const TestFactory& factory, MyTypes::WorkloadProfile profile, uint32_t seed,
+                    size_t monsters, size_t chunkMonsters, size_t maxThreads, size_t samples);
+
+//deserialize into pmr list on monotonic arena released after every call, compared to global allocator
+void runArenaBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples);
+
+void runThroughputScaling(const TestFactory& factory, const std::vector<MyTypes::Monster>& data,
+                          size_t maxThreads, size_t samples);
+
+#endif //CPP_SERIALIZERS_BENCHMARK_BENCHMARKS_H
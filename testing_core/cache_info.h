@@ -0,0 +1,55 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_CACHE_INFO_H
+#define CPP_SERIALIZERS_BENCHMARK_CACHE_INFO_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+//size of last level cache in bytes, or 32MiB when it cannot be detected
+inline size_t lastLevelCacheSize() {
+    constexpr size_t DEFAULT_SIZE = 32u << 20;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    if (auto size = sysconf(_SC_LEVEL3_CACHE_SIZE); size > 0)
+        return static_cast<size_t>(size);
+#endif
+#if defined(__linux__)
+    for (auto index: {3, 2}) {
+        std::ifstream file{"/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size"};
+        size_t size{};
+        std::string unit{};
+        if (file >> size) {
+            file >> unit;
+            return unit == "M" ? size << 20 : unit == "K" ? size << 10 : size;
+        }
+    }
+#endif
+    return DEFAULT_SIZE;
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_CACHE_INFO_H
@@ -0,0 +1,298 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "chunked.h"
+#include "benchmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+std::vector<Chunk> readChunkTable(Buf snapshot) {
+    uint64_t count{};
+    if (snapshot.bytesCount < sizeof(count))
+        return {};
+    std::memcpy(&count, snapshot.ptr, sizeof(count));
+    if (count >= snapshot.bytesCount / sizeof(count) / 2)
+        return {};
+    const auto tableBytes = (2 * count + 1) * sizeof(count);
+    const auto payload = snapshot.ptr + tableBytes;
+    const auto payloadBytes = snapshot.bytesCount - tableBytes;
+    std::vector<Chunk> chunks{};
+    chunks.reserve(count);
+    uint64_t first{};
+    uint64_t begin{};
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t entry[2]{};
+        std::memcpy(entry, snapshot.ptr + (2 * i + 1) * sizeof(count), sizeof(entry));
+        const auto [last, end] = entry;
+        if (last < first || end < begin || end > payloadBytes)
+            return {};
+        chunks.push_back({{payload + begin, end - begin}, first, last - first});
+        first = last;
+        begin = end;
+    }
+    return chunks;
+}
+
+size_t sinkCapacity(std::span<const MyTypes::Monster> data) {
+    return 2 * MyTypes::serializedSizeUpperBound(data);
+}
+
+ChunkedSerializer::ChunkedSerializer(const TestFactory& factory, size_t threads)
+        : _pool{threads},
+          _workerBuffers(threads),
+          _workerUsed(threads) {
+    for (size_t w = 0; w < threads; ++w)
+        _tests.push_back(factory());
+}
+
+bool ChunkedSerializer::serialize(const std::vector<MyTypes::Monster>& data, size_t chunkMonsters,
+                                  std::vector<uint8_t>& out) {
+    const std::span<const MyTypes::Monster> all{data};
+    const auto count = (all.size() + chunkMonsters - 1) / chunkMonsters;
+    _chunks.resize(count);
+    std::fill(_workerUsed.begin(), _workerUsed.end(), 0);
+    std::atomic<bool> failed{false};
+    _pool.run(count, [&](size_t i, size_t worker) {
+        const auto first = i * chunkMonsters;
+        const auto range = all.subspan(first, std::min(chunkMonsters, all.size() - first));
+        const auto capacity = sinkCapacity(range);
+        auto& dst = _workerBuffers[worker];
+        auto& used = _workerUsed[worker];
+        if (dst.size() < used + capacity)
+            dst.resize(std::max(used + capacity, 2 * dst.size()));
+        const auto written = _tests[worker]->serializeRangeInto(range, {dst.data() + used, capacity});
+        if (written == 0)
+            failed = true;
+        _chunks[i] = {worker, used, written};
+        used += written;
+    });
+    if (failed)
+        return false;
+
+    //write table, then copy chunks to their place in parallel
+    const auto tableBytes = (2 * count + 1) * sizeof(uint64_t);
+    std::vector<uint64_t> table{count};
+    std::vector<size_t> begins(count);
+    size_t bytes{};
+    for (size_t i = 0; i < count; ++i) {
+        begins[i] = bytes;
+        bytes += _chunks[i].size;
+        table.push_back(std::min((i + 1) * chunkMonsters, all.size()));
+        table.push_back(bytes);
+    }
+    out.resize(tableBytes + bytes);
+    std::memcpy(out.data(), table.data(), tableBytes);
+    _pool.run(count, [&](size_t i, size_t) {
+        const auto& c = _chunks[i];
+        std::memcpy(out.data() + tableBytes + begins[i], _workerBuffers[c.worker].data() + c.offset, c.size);
+    });
+    return true;
+}
+
+ChunkedDeserializer::ChunkedDeserializer(const TestFactory& factory, size_t threads)
+        : _pool{threads} {
+    for (size_t w = 0; w < threads; ++w)
+        _tests.push_back(factory());
+}
+
+bool ChunkedDeserializer::deserialize(Buf snapshot, std::vector<MyTypes::Monster>& res) {
+    const auto chunks = readChunkTable(snapshot);
+    if (chunks.empty() && snapshot.bytesCount != sizeof(uint64_t))
+        return false;
+    res.resize(chunks.empty() ? 0 : chunks.back().first + chunks.back().count);
+    const std::span<MyTypes::Monster> slots{res};
+    std::atomic<bool> failed{false};
+    _pool.run(chunks.size(), [&](size_t i, size_t worker) {
+        const auto& c = chunks[i];
+        if (!_tests[worker]->deserializeRange(c.buf, slots.subspan(c.first, c.count)))
+            failed = true;
+    });
+    return !failed;
+}
+
+void runChunkedScaling(const TestFactory& factory, MyTypes::WorkloadProfile profile, uint32_t seed,
+                       size_t monsters, size_t chunkMonsters, size_t maxThreads, size_t samples) {
+    if (!factory) {
+        std::cout << "* chunked: skipped, test doesn't provide factory" << std::endl;
+        return;
+    }
+    if (chunkMonsters == 0) {
+        std::cout << "* chunked: chunk size must be positive, skip." << std::endl;
+        return;
+    }
+    const auto data = MyTypes::createMonstersParallel(monsters, profile, seed);
+    auto probe = factory();
+
+    std::vector<size_t> threadCounts{};
+    for (size_t n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<uint8_t> expected{};
+    double singleNs{};
+    for (auto n: threadCounts) {
+        ChunkedSerializer chunked{factory, n};
+        std::vector<uint8_t> out{};
+        if (!chunked.serialize(data, chunkMonsters, out)) {
+            std::cout << "* chunked " << n << " threads: chunk doesn't fit in output buffer, abort." << std::endl;
+            return;
+        }
+        if (n == 1) {
+            //every chunk must decode to its range of monsters
+            const auto chunks = readChunkTable({out.data(), out.size()});
+            if (chunks.size() != (data.size() + chunkMonsters - 1) / chunkMonsters) {
+                std::cout << "* chunked: invalid chunk table, abort." << std::endl;
+                return;
+            }
+            std::vector<MyTypes::Monster> res{};
+            for (auto& c: chunks) {
+                probe->deserialize(c.buf, res);
+                const auto first = data.begin() + static_cast<std::ptrdiff_t>(c.first);
+                if (!std::equal(res.begin(), res.end(), first, first + static_cast<std::ptrdiff_t>(c.count))) {
+                    std::cout << "* chunked: chunk at " << c.first << " != data, abort." << std::endl;
+                    return;
+                }
+            }
+            expected = out;
+            std::ostringstream line{};
+            line << "* chunked    : " << data.size() << " monsters, " << chunks.size() << " chunks of "
+                 << chunkMonsters << " monsters, " << out.size() << " bytes";
+            std::cout << line.str() << std::endl;
+        } else if (out != expected) {
+            std::cout << "* chunked " << n << " threads: result differs from single thread, abort." << std::endl;
+            return;
+        }
+
+        const auto start = BenchClock::now();
+        for (size_t i = 0; i < samples; ++i)
+            chunked.serialize(data, chunkMonsters, out);
+        const auto ns = static_cast<double>(elapsedNs(start, BenchClock::now())) / static_cast<double>(samples);
+        if (n == 1)
+            singleNs = ns;
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(2) << "* chunked " << n << " threads: " << ns / 1e6
+             << " ms/snapshot, " << static_cast<double>(out.size()) * 1e3 / ns << " MB/s ("
+             << singleNs / ns << "x)";
+        std::cout << line.str() << std::endl;
+    }
+
+    //plain single threaded serialization of whole list, into buffer of same kind as chunks
+    std::vector<uint8_t> whole(sinkCapacity(data));
+    const OutputSink sink{whole.data(), whole.size()};
+    size_t wholeBytes = probe->serializeInto(data, sink);
+    if (wholeBytes == 0) {
+        std::cout << "* chunked    : whole list doesn't fit in output buffer" << std::endl;
+        return;
+    }
+    const auto start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i)
+        wholeBytes = probe->serializeInto(data, sink);
+    const auto ns = static_cast<double>(elapsedNs(start, BenchClock::now())) / static_cast<double>(samples);
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(2) << "* chunked    : whole list serialize " << ns / 1e6
+         << " ms/snapshot, " << static_cast<double>(wholeBytes) * 1e3 / ns << " MB/s (" << singleNs / ns << "x)";
+    std::cout << line.str() << std::endl;
+}
+
+void runChunkedLoad(const TestFactory& factory, MyTypes::WorkloadProfile profile, uint32_t seed,
+                    size_t monsters, size_t chunkMonsters, size_t maxThreads, size_t samples) {
+    if (!factory) {
+        std::cout << "* chunked load: skipped, test doesn't provide factory" << std::endl;
+        return;
+    }
+    if (chunkMonsters == 0) {
+        std::cout << "* chunked load: chunk size must be positive, skip." << std::endl;
+        return;
+    }
+    const auto data = MyTypes::createMonstersParallel(monsters, profile, seed);
+    auto probe = factory();
+    std::vector<uint8_t> snapshot{};
+    if (!ChunkedSerializer{factory, 1}.serialize(data, chunkMonsters, snapshot)) {
+        std::cout << "* chunked load: chunk doesn't fit in output buffer, abort." << std::endl;
+        return;
+    }
+
+    //every load starts with empty list, like at startup; result is destroyed outside of timed region
+    auto timeLoad = [&](auto&& load) {
+        uint64_t total{};
+        for (size_t i = 0; i < samples; ++i) {
+            std::vector<MyTypes::Monster> res{};
+            const auto start = BenchClock::now();
+            const auto ok = load(res);
+            total += elapsedNs(start, BenchClock::now());
+            if (!ok || res != data)
+                return -1.0;
+        }
+        return static_cast<double>(total) / static_cast<double>(samples);
+    };
+    auto print = [](const std::string& name, double ns, double baselineNs) {
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(2) << "* chunked load " << name << ": " << ns / 1e6
+             << " ms/load (" << baselineNs / ns << "x)";
+        std::cout << line.str() << std::endl;
+    };
+
+    //sequential deserialize of whole list, it is written with serializeInto, so it is not limited by test's buffer
+    std::vector<uint8_t> whole(std::max(sinkCapacity(data), 2 * snapshot.size()));
+    const auto wholeBytes = probe->serializeInto(data, {whole.data(), whole.size()});
+    double baselineNs{};
+    if (wholeBytes != 0) {
+        baselineNs = timeLoad([&](std::vector<MyTypes::Monster>& res) {
+            probe->deserialize({whole.data(), wholeBytes}, res);
+            return true;
+        });
+        if (baselineNs < 0) {
+            std::cout << "* chunked load: sequential result != data, abort." << std::endl;
+            return;
+        }
+    }
+
+    std::ostringstream line{};
+    line << "* chunked load: " << data.size() << " monsters, " << (data.size() + chunkMonsters - 1) / chunkMonsters
+         << " chunks of " << chunkMonsters << " monsters, " << snapshot.size() << " bytes";
+    std::cout << line.str() << std::endl;
+    if (wholeBytes != 0)
+        print("sequential", baselineNs, baselineNs);
+    else
+        std::cout << "* chunked load sequential: whole list doesn't fit, speedup is relative to 1 thread" << std::endl;
+
+    std::vector<size_t> threadCounts{};
+    for (size_t n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+    for (auto n: threadCounts) {
+        ChunkedDeserializer chunked{factory, n};
+        const auto ns = timeLoad([&](std::vector<MyTypes::Monster>& res) {
+            return chunked.deserialize({snapshot.data(), snapshot.size()}, res);
+        });
+        if (ns < 0) {
+            std::cout << "* chunked load " << n << " threads: result != data, abort." << std::endl;
+            return;
+        }
+        if (baselineNs == 0)
+            baselineNs = ns;
+        print(std::to_string(n) + " threads", ns, baselineNs);
+    }
+}
@@ -0,0 +1,84 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_CHUNKED_H
+#define CPP_SERIALIZERS_BENCHMARK_CHUNKED_H
+
+#include <testing/test.h>
+#include <memory>
+#include <vector>
+#include "thread_pool.h"
+
+//chunked snapshot layout, all integers are uint64 in native byte order:
+//chunks count, for every chunk index past its last monster and end offset relative to end of this table,
+//then chunks back to back. every chunk is a range of monsters serialized by test, so it can be read on its own
+struct Chunk {
+    Buf buf;
+    size_t first;
+    size_t count;
+};
+
+//returns empty list if table is malformed
+std::vector<Chunk> readChunkTable(Buf snapshot);
+
+//formats other than handwritten can be a bit bigger than MyTypes::serializedSizeUpperBound
+//(e.g. archive headers or 4 byte enums), so buffers for serializeInto are sized with this margin
+size_t sinkCapacity(std::span<const MyTypes::Monster> data);
+
+//serializes chunks of monster list on a thread pool, every worker has its own test instance and buffer,
+//chunks are written directly into worker's buffer with serializeRangeInto
+class ChunkedSerializer {
+public:
+    ChunkedSerializer(const TestFactory& factory, size_t threads);
+
+    //returns false if test failed to serialize some chunk
+    bool serialize(const std::vector<MyTypes::Monster>& data, size_t chunkMonsters, std::vector<uint8_t>& out);
+
+private:
+    struct ChunkLocation {
+        size_t worker;
+        size_t offset;
+        size_t size;
+    };
+
+    ThreadPool _pool;
+    std::vector<std::unique_ptr<ISerializerTest>> _tests{};
+    //buffers only grow, so bytes are not cleared on every snapshot
+    std::vector<std::vector<uint8_t>> _workerBuffers{};
+    std::vector<size_t> _workerUsed{};
+    std::vector<ChunkLocation> _chunks{};
+};
+
+//decodes chunks of snapshot on a thread pool directly into their slots of result list
+class ChunkedDeserializer {
+public:
+    ChunkedDeserializer(const TestFactory& factory, size_t threads);
+
+    //returns false if snapshot is malformed
+    bool deserialize(Buf snapshot, std::vector<MyTypes::Monster>& res);
+
+private:
+    ThreadPool _pool;
+    std::vector<std::unique_ptr<ISerializerTest>> _tests{};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_CHUNKED_H
@@ -0,0 +1,136 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "cache_info.h"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    class LatencyRecorder {
+    public:
+        template<typename Op>
+        void operator()(LatencyHistogram& hist, Op&& op) {
+            auto start = BenchClock::now();
+            op();
+            auto ns = elapsedNs(start, BenchClock::now());
+            hist.record(ns > _overhead ? ns - _overhead : 0);
+        }
+    private:
+        uint64_t _overhead = timerOverheadNs();
+    };
+
+    //every call uses different data, input buffer and destination object,
+    //all of them together are bigger than last level cache
+    void runRotation(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data,
+                     MyTypes::WorkloadProfile profile, uint32_t seed, size_t coldBytes) {
+        const auto bytesPerSet = std::max<size_t>(1, testCase.serialize(data).bytesCount);
+        const auto sets = std::max<size_t>(2, (coldBytes + bytesPerSet - 1) / bytesPerSet);
+
+        //generate all sets at once in parallel, and split them afterwards
+        auto all = MyTypes::createMonstersParallel(sets * data.size(), profile, seed + 1);
+        std::vector<std::vector<MyTypes::Monster>> datasets(sets);
+        for (size_t i = 0; i < sets; ++i) {
+            auto first = std::make_move_iterator(all.begin() + static_cast<ptrdiff_t>(i * data.size()));
+            datasets[i].assign(first, first + static_cast<ptrdiff_t>(data.size()));
+        }
+        all = {};
+
+        //own copy of every serialized set, because test returns its internal buffer
+        std::vector<std::vector<uint8_t>> inputs(sets);
+        std::vector<std::vector<MyTypes::Monster>> results(sets);
+        size_t totalBytes{};
+        for (size_t i = 0; i < sets; ++i) {
+            if (MyTypes::serializedSizeUpperBound(datasets[i]) > testCase.bufferCapacity()) {
+                std::cout << "* cold rotate: data set might not fit in output buffer, skip." << std::endl;
+                return;
+            }
+            auto buf = testCase.serialize(datasets[i]);
+            inputs[i].assign(buf.ptr, buf.ptr + buf.bytesCount);
+            totalBytes += buf.bytesCount;
+            //deserialize on top of old object, same as default measurement
+            testCase.deserialize(Buf{inputs[i].data(), inputs[i].size()}, results[i]);
+            if (results[i] != datasets[i]) {
+                std::cout << "* cold rotate: result != data, abort." << std::endl;
+                return;
+            }
+        }
+        std::cout << "* cold rotate: " << sets << " data sets, " << (totalBytes >> 20) << "MiB serialized" << std::endl;
+
+        LatencyRecorder record{};
+        LatencyHistogram serHist{};
+        for (auto& d: datasets)
+            record(serHist, [&] { testCase.serialize(d); });
+        printLatency("cold rotate ser latency", serHist);
+
+        LatencyHistogram desHist{};
+        for (size_t i = 0; i < sets; ++i)
+            record(desHist, [&] { testCase.deserialize(Buf{inputs[i].data(), inputs[i].size()}, results[i]); });
+        printLatency("cold rotate des latency", desHist);
+    }
+
+    //same data as default measurement, but every cache line of eviction buffer is written between calls
+    void runEviction(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                     size_t coldBytes, size_t samples) {
+        std::vector<uint8_t> evictBuf(coldBytes);
+        auto evict = [&evictBuf] {
+            for (size_t i = 0; i < evictBuf.size(); i += CACHE_LINE_SIZE)
+                ++evictBuf[i];
+        };
+        //serialization might return internal buffer that is overwritten, keep own copy for deserialization
+        std::vector<uint8_t> input(buf.ptr, buf.ptr + buf.bytesCount);
+        buf = Buf{input.data(), input.size()};
+
+        LatencyRecorder record{};
+        LatencyHistogram serHist{};
+        for (size_t i = 0; i < samples; ++i) {
+            evict();
+            record(serHist, [&] { testCase.serialize(data); });
+        }
+        printLatency("cold evict ser latency", serHist);
+
+        //deserialize on top of old object, same as default measurement
+        std::vector<MyTypes::Monster> res{};
+        testCase.deserialize(buf, res);
+        LatencyHistogram desHist{};
+        for (size_t i = 0; i < samples; ++i) {
+            evict();
+            record(desHist, [&] { testCase.deserialize(buf, res); });
+        }
+        printLatency("cold evict des latency", desHist);
+    }
+
+}
+
+void runColdCacheBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                           MyTypes::WorkloadProfile profile, uint32_t seed, const std::string& mode,
+                           size_t coldBytes, size_t samples) {
+    const bool both = mode != "rotate" && mode != "evict";
+    if (both || mode == "evict")
+        runEviction(testCase, data, buf, coldBytes ? coldBytes : 2 * lastLevelCacheSize(), samples);
+    //source objects and destination objects are several times bigger than serialized data,
+    //so serialized data alone doesn't need to exceed the cache
+    if (both || mode == "rotate")
+        runRotation(testCase, data, profile, seed, coldBytes ? coldBytes : lastLevelCacheSize());
+}
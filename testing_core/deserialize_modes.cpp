@@ -0,0 +1,112 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "alloc_tracking.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    //fresh destinations are created and destroyed outside of timed region in batches of this size
+    constexpr size_t FRESH_BATCH_SIZE = 64;
+
+    enum class DeserializeMode {
+        //deserialize on top of old object, same as default measurement
+        REUSE,
+        //new empty vector for every call
+        FRESH,
+        //same vector, but cleared before every call, so strings and vectors of monsters are freed
+        CLEARED,
+    };
+
+    struct ModeResult {
+        uint64_t totalNs;
+        uint64_t allocations;
+    };
+
+    //destinations are created and primed before each timed loop, so when countAllocations is set,
+    //only allocations made by deserialize calls in the loop (and clearing in CLEARED mode) are counted
+    ModeResult deserializeInMode(ISerializerTest& testCase, Buf buf, DeserializeMode mode, size_t samples,
+                                 bool countAllocations) {
+        ModeResult result{};
+        auto begin = [countAllocations]() {
+            if (countAllocations)
+                startAllocTracking();
+            return BenchClock::now();
+        };
+        auto end = [&](BenchClock::time_point start) {
+            result.totalNs += elapsedNs(start, BenchClock::now());
+            if (countAllocations)
+                result.allocations += stopAllocTracking().allocations;
+        };
+        if (mode == DeserializeMode::FRESH) {
+            for (size_t done = 0; done < samples;) {
+                const auto batch = std::min(FRESH_BATCH_SIZE, samples - done);
+                std::vector<std::vector<MyTypes::Monster>> results(batch);
+                const auto start = begin();
+                for (auto& res: results)
+                    testCase.deserialize(buf, res);
+                end(start);
+                done += batch;
+            }
+            return result;
+        }
+        std::vector<MyTypes::Monster> res{};
+        testCase.deserialize(buf, res);
+        const auto start = begin();
+        for (size_t i = 0; i < samples; ++i) {
+            if (mode == DeserializeMode::CLEARED)
+                res.clear();
+            testCase.deserialize(buf, res);
+        }
+        end(start);
+        return result;
+    }
+
+}
+
+void runDeserializeModes(ISerializerTest& testCase, Buf buf, size_t samples) {
+    const std::pair<DeserializeMode, const char*> modes[] = {
+        {DeserializeMode::REUSE, "reuse"},
+        {DeserializeMode::FRESH, "fresh"},
+        {DeserializeMode::CLEARED, "cleared"},
+    };
+    double reuseNs{};
+    for (auto [mode, name]: modes) {
+        const auto ns = static_cast<double>(deserializeInMode(testCase, buf, mode, samples, false).totalNs) /
+                        static_cast<double>(samples);
+        if (mode == DeserializeMode::REUSE)
+            reuseNs = ns;
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(1) << "* des " << name << ": " << ns << " ns/call ("
+             << ns / reuseNs << "x reuse)";
+        if (allocTrackingSupported()) {
+            //separate pass, so counting doesn't affect timing
+            const auto countedSamples = std::min<size_t>(samples, 100);
+            const auto counted = deserializeInMode(testCase, buf, mode, countedSamples, true);
+            line << ", " << static_cast<double>(counted.allocations) / static_cast<double>(countedSamples)
+                 << " allocations per call";
+        }
+        std::cout << line.str() << std::endl;
+    }
+}
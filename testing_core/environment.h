@@ -0,0 +1,51 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_ENVIRONMENT_H
+#define CPP_SERIALIZERS_BENCHMARK_ENVIRONMENT_H
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+//optional measurements are enabled through environment variables,
+//so that every test executable can be configured without recompiling and plain `ctest` output stays unchanged.
+inline bool getEnvFlag(const char* name) {
+    auto value = std::getenv(name);
+    return value != nullptr && *value != '\0' && std::strcmp(value, "0") != 0;
+}
+
+inline size_t getEnvSize(const char* name, size_t defaultValue) {
+    auto value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+        return defaultValue;
+    char* end{};
+    auto res = std::strtoull(value, &end, 10);
+    return *end == '\0' ? static_cast<size_t>(res) : defaultValue;
+}
+
+inline std::string getEnvString(const char* name, const std::string& defaultValue = {}) {
+    auto value = std::getenv(name);
+    return value != nullptr ? std::string{value} : defaultValue;
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_ENVIRONMENT_H
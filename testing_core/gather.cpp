@@ -0,0 +1,141 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "io_utils.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+
+namespace {
+
+    //pipe with a thread that reads and discards everything written to it
+    class DrainedPipe {
+    public:
+        bool open(std::string& error) {
+            int fds[2];
+            if (pipe2(fds, O_CLOEXEC) != 0) {
+                error = std::string{"pipe2: "} + std::strerror(errno);
+                return false;
+            }
+            _readFd = fds[0];
+            _writeFd = fds[1];
+            //bigger pipe buffer means fewer context switches between writer and drain thread
+            fcntl(_writeFd, F_SETPIPE_SZ, PIPE_SIZE);
+            _drain = std::thread{[fd = _readFd] {
+                std::vector<uint8_t> buf(PIPE_SIZE);
+                while (read(fd, buf.data(), buf.size()) > 0) {
+                }
+            }};
+            return true;
+        }
+
+        int fd() const {
+            return _writeFd;
+        }
+
+        ~DrainedPipe() {
+            if (_writeFd >= 0)
+                close(_writeFd);
+            if (_drain.joinable())
+                _drain.join();
+            if (_readFd >= 0)
+                close(_readFd);
+        }
+
+    private:
+        static constexpr size_t PIPE_SIZE = 1u << 20;
+        int _readFd{-1};
+        int _writeFd{-1};
+        std::thread _drain{};
+    };
+
+}
+
+void runGatherBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples) {
+    std::vector<Buf> segments{};
+    if (!testCase.serializeGather(data, segments)) {
+        std::cout << "* gather: not supported" << std::endl;
+        return;
+    }
+    std::vector<uint8_t> joined{};
+    for (auto& s: segments)
+        joined.insert(joined.end(), s.ptr, s.ptr + s.bytesCount);
+    auto buf = testCase.serialize(data);
+    if (!std::equal(joined.begin(), joined.end(), buf.ptr, buf.ptr + buf.bytesCount)) {
+        std::cout << "* gather: result != serialize result, abort." << std::endl;
+        return;
+    }
+
+    DrainedPipe pipe{};
+    std::string error{};
+    if (!pipe.open(error)) {
+        std::cout << "* gather: unavailable, " << error << std::endl;
+        return;
+    }
+
+    //serialize into contiguous buffer and write it
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        buf = testCase.serialize(data);
+        iovec part{const_cast<uint8_t*>(buf.ptr), buf.bytesCount};
+        if (!writeAll(pipe.fd(), &part, 1)) {
+            std::cout << "* gather: write failed, abort." << std::endl;
+            return;
+        }
+    }
+    const auto copyNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    std::vector<iovec> parts{};
+    start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        testCase.serializeGather(data, segments);
+        parts.resize(segments.size());
+        std::transform(segments.begin(), segments.end(), parts.begin(), [](const Buf& s) {
+            return iovec{const_cast<uint8_t*>(s.ptr), s.bytesCount};
+        });
+        if (!writeAll(pipe.fd(), parts.data(), parts.size())) {
+            std::cout << "* gather: write failed, abort." << std::endl;
+            return;
+        }
+    }
+    const auto gatherNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    const auto n = static_cast<double>(samples);
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* gather     : " << segments.size() << " segments, "
+         << "serialize+write " << copyNs / n << " ns/call, gather+writev " << gatherNs / n << " ns/call ("
+         << copyNs / gatherNs << "x)";
+    std::cout << line.str() << std::endl;
+}
+
+#else
+
+void runGatherBenchmark(ISerializerTest&, const std::vector<MyTypes::Monster>&, size_t) {
+    std::cout << "* gather: unavailable, only implemented on linux" << std::endl;
+}
+
+#endif
@@ -0,0 +1,108 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_HISTOGRAM_H
+#define CPP_SERIALIZERS_BENCHMARK_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+//HDR style histogram with log-bucketed values, values below 128 are stored exactly,
+//bigger values are stored in 64 linear sub-buckets per power of two, so relative error is less than 1.6%.
+class LatencyHistogram {
+public:
+    void record(uint64_t value) {
+        ++_counts[indexOf(value)];
+        ++_count;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < _counts.size(); ++i)
+            _counts[i] += other._counts[i];
+        _count += other._count;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    uint64_t min() const {
+        return _count ? _min : 0;
+    }
+
+    uint64_t max() const {
+        return _max;
+    }
+
+    //returns highest value that is equivalent to the bucket where percentile falls, p in range [0, 100]
+    uint64_t percentile(double p) const {
+        if (_count == 0)
+            return 0;
+        auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(_count)));
+        rank = std::clamp<uint64_t>(rank, 1, _count);
+        uint64_t seen{};
+        for (size_t i = 0; i < _counts.size(); ++i) {
+            seen += _counts[i];
+            if (seen >= rank)
+                return std::clamp(highestEquivalentValue(i), min(), _max);
+        }
+        return _max;
+    }
+
+private:
+    static constexpr unsigned SUB_BUCKET_BITS = 6;
+    static constexpr uint64_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS + 2 * SUB_BUCKETS;
+
+    static unsigned highestBit(uint64_t value) {
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+    }
+
+    static size_t indexOf(uint64_t value) {
+        if (value < 2 * SUB_BUCKETS)
+            return value;
+        auto shift = highestBit(value) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKETS + (value >> shift);
+    }
+
+    static uint64_t highestEquivalentValue(size_t index) {
+        if (index < 2 * SUB_BUCKETS)
+            return index;
+        auto shift = index / SUB_BUCKETS - 1;
+        auto sub = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::array<uint64_t, BUCKETS_COUNT> _counts{};
+    uint64_t _count{};
+    uint64_t _min{std::numeric_limits<uint64_t>::max()};
+    uint64_t _max{};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_HISTOGRAM_H
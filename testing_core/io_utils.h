@@ -0,0 +1,77 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_IO_UTILS_H
+#define CPP_SERIALIZERS_BENCHMARK_IO_UTILS_H
+
+#if defined(__linux__)
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <sys/uio.h>
+#include <unistd.h>
+
+//writes all parts, retrying partial writes and splitting lists longer than IOV_MAX. parts are modified
+inline bool writeAll(int fd, iovec* parts, size_t count) {
+    auto end = parts + count;
+    while (parts != end && parts->iov_len == 0)
+        ++parts;
+    while (parts != end) {
+        const auto batch = static_cast<int>(std::min<ptrdiff_t>(end - parts, IOV_MAX));
+        auto written = writev(fd, parts, batch);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        //skip fully written parts, and advance partially written one
+        for (auto w = static_cast<size_t>(written); parts != end && (w || parts->iov_len == 0); ++parts) {
+            const auto n = std::min(w, parts->iov_len);
+            w -= n;
+            if (n < parts->iov_len) {
+                parts->iov_base = static_cast<uint8_t*>(parts->iov_base) + n;
+                parts->iov_len -= n;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+//reads exactly size bytes, returns false on error or end of file
+inline bool readExact(int fd, void* dst, size_t size) {
+    auto pos = static_cast<uint8_t*>(dst);
+    while (size) {
+        auto n = read(fd, pos, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        pos += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+#endif
+
+#endif //CPP_SERIALIZERS_BENCHMARK_IO_UTILS_H
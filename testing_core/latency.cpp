@@ -0,0 +1,80 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "benchmarks.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+uint64_t timerOverheadNs() {
+    static const uint64_t overhead = [] {
+        std::vector<uint64_t> samples(100000);
+        for (auto& s: samples) {
+            auto start = BenchClock::now();
+            auto end = BenchClock::now();
+            s = elapsedNs(start, end);
+        }
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return samples[samples.size() / 2];
+    }();
+    return overhead;
+}
+
+void printLatency(const std::string& label, const LatencyHistogram& hist) {
+    std::cout << "* " << label << ": min " << hist.min()
+              << " p50 " << hist.percentile(50)
+              << " p90 " << hist.percentile(90)
+              << " p99 " << hist.percentile(99)
+              << " p99.9 " << hist.percentile(99.9)
+              << " max " << hist.max() << " (ns)" << std::endl;
+}
+
+void runLatencyBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                         size_t samples) {
+    const auto overhead = timerOverheadNs();
+    std::cout << "* timer overhead: " << overhead << "ns, subtracted from each sample" << std::endl;
+    auto record = [overhead](LatencyHistogram& hist, BenchClock::time_point start, BenchClock::time_point end) {
+        auto ns = elapsedNs(start, end);
+        hist.record(ns > overhead ? ns - overhead : 0);
+    };
+
+    LatencyHistogram serHist{};
+    for (size_t i = 0; i < samples; ++i) {
+        auto start = BenchClock::now();
+        testCase.serialize(data);
+        auto end = BenchClock::now();
+        record(serHist, start, end);
+    }
+    printLatency("ser latency", serHist);
+
+    //deserialize on top of old object, same as default measurement
+    std::vector<MyTypes::Monster> res{};
+    testCase.deserialize(buf, res);
+    LatencyHistogram desHist{};
+    for (size_t i = 0; i < samples; ++i) {
+        auto start = BenchClock::now();
+        testCase.deserialize(buf, res);
+        auto end = BenchClock::now();
+        record(desHist, start, end);
+    }
+    printLatency("des latency", desHist);
+}
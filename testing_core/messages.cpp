@@ -0,0 +1,69 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+void runMessageRateBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages) {
+    //every monster is separate message, so per call setup is not amortized over whole list
+    std::vector<std::vector<MyTypes::Monster>> inputs{};
+    inputs.reserve(data.size());
+    for (auto& m: data)
+        inputs.push_back({m});
+
+    //serialized messages are stored back to back, because serialize result is valid only until next call
+    std::vector<uint8_t> storage{};
+    std::vector<size_t> offsets{0};
+    std::vector<MyTypes::Monster> res{};
+    for (auto& in: inputs) {
+        const auto buf = testCase.serialize(in);
+        storage.insert(storage.end(), buf.ptr, buf.ptr + buf.bytesCount);
+        offsets.push_back(storage.size());
+        testCase.deserialize(buf, res);
+        if (res != in) {
+            std::cout << "* messages: result != data, abort." << std::endl;
+            return;
+        }
+    }
+    auto message = [&](size_t i) {
+        return Buf{storage.data() + offsets[i], offsets[i + 1] - offsets[i]};
+    };
+
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < messages; ++i)
+        testCase.serialize(inputs[i % inputs.size()]);
+    const auto serNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    start = BenchClock::now();
+    for (size_t i = 0; i < messages; ++i)
+        testCase.deserialize(message(i % inputs.size()), res);
+    const auto desNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    const auto n = static_cast<double>(messages);
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* messages   : " << static_cast<double>(storage.size()) /
+         static_cast<double>(inputs.size()) << " B/message, serialize " << serNs / n << " ns ("
+         << n * 1e3 / serNs << " M messages/s), deserialize " << desNs / n << " ns ("
+         << n * 1e3 / desNs << " M messages/s)";
+    std::cout << line.str() << std::endl;
+}
@@ -0,0 +1,155 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+    //each measured loop runs at least this long, so clock resolution doesn't matter
+    constexpr uint64_t MIN_LOOP_NS = 2000000;
+    //fastest of several loops is used, it is least affected by interrupts
+    constexpr size_t LOOP_TRIALS = 5;
+    //element counts of measured messages, empty message measures fixed per call cost directly
+    constexpr size_t ELEMENT_COUNTS[] = {0, 1, 2, 4, 8, 16, 32, 64, 128};
+
+    struct Point {
+        double bytes;
+        double serializeNs;
+        double deserializeNs;
+    };
+
+    //returns ns per call of fn
+    template<typename Fn>
+    double timePerCall(Fn&& fn) {
+        size_t reps = 16;
+        for (;;) {
+            const auto start = BenchClock::now();
+            for (size_t i = 0; i < reps; ++i)
+                fn();
+            if (elapsedNs(start, BenchClock::now()) >= MIN_LOOP_NS)
+                break;
+            reps *= 2;
+        }
+        auto best = std::numeric_limits<uint64_t>::max();
+        for (size_t t = 0; t < LOOP_TRIALS; ++t) {
+            const auto start = BenchClock::now();
+            for (size_t i = 0; i < reps; ++i)
+                fn();
+            best = std::min(best, elapsedNs(start, BenchClock::now()));
+        }
+        return static_cast<double>(best) / static_cast<double>(reps);
+    }
+
+    //least squares slope of ns over bytes
+    double costPerByte(const std::vector<Point>& points, double Point::* ns) {
+        const auto n = static_cast<double>(points.size());
+        double sx{}, sy{}, sxx{}, sxy{};
+        for (auto& p: points) {
+            sx += p.bytes;
+            sy += p.*ns;
+            sxx += p.bytes * p.bytes;
+            sxy += p.bytes * p.*ns;
+        }
+        return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    }
+
+    //monster with empty strings and containers, so message size is dominated by measured type
+    MyTypes::Monster emptyMonster() {
+        return MyTypes::Monster{{}, 0, 0, {}, {}, MyTypes::Color::Red, {}, {{}, 0}, {}};
+    }
+
+}
+
+void runTypeMicrobenchmarks(ISerializerTest& testCase, uint32_t seed) {
+    //values for vec3 and weapon messages are taken from default generator
+    const auto source = MyTypes::createMonsters(64, MyTypes::WorkloadProfile::DEFAULT, seed);
+    std::vector<MyTypes::Vec3> points{};
+    std::vector<MyTypes::Weapon> weapons{};
+    for (auto& m: source) {
+        points.insert(points.end(), m.path.begin(), m.path.end());
+        weapons.insert(weapons.end(), m.weapons.begin(), m.weapons.end());
+    }
+
+    //vec3 is measured as path points, weapons as weapons list and monsters as list of monsters;
+    //every kind starts from the same single empty monster, so that zero point is equal for all kinds
+    const std::pair<const char*, std::function<std::vector<MyTypes::Monster>(size_t)>> kinds[] = {
+        {"vec3   ", [&](size_t count) {
+            auto m = emptyMonster();
+            for (size_t i = 0; i < count; ++i)
+                m.path.push_back(points[i % points.size()]);
+            return std::vector<MyTypes::Monster>{m};
+        }},
+        {"weapon ", [&](size_t count) {
+            auto m = emptyMonster();
+            for (size_t i = 0; i < count; ++i)
+                m.weapons.push_back(weapons[i % weapons.size()]);
+            return std::vector<MyTypes::Monster>{m};
+        }},
+        {"monster", [&](size_t count) {
+            std::vector<MyTypes::Monster> res{emptyMonster()};
+            const auto monsters = MyTypes::createMonsters(count, MyTypes::WorkloadProfile::DEFAULT, seed);
+            res.insert(res.end(), monsters.begin(), monsters.end());
+            return res;
+        }},
+    };
+
+    for (auto& [name, make]: kinds) {
+        std::vector<Point> measured{};
+        std::vector<MyTypes::Monster> res{};
+        for (auto count: ELEMENT_COUNTS) {
+            const auto data = make(count);
+            if (MyTypes::serializedSizeUpperBound(data) > testCase.bufferCapacity())
+                break;
+            const auto buf = testCase.serialize(data);
+            //keep own copy, serialize result might be changed by next call
+            const std::vector<uint8_t> bytes(buf.ptr, buf.ptr + buf.bytesCount);
+            const Buf input{bytes.data(), bytes.size()};
+            testCase.deserialize(input, res);
+            if (res != data) {
+                std::cout << "* micro " << name << ": result != data, abort." << std::endl;
+                return;
+            }
+            Point p{static_cast<double>(bytes.size()), 0, 0};
+            p.serializeNs = timePerCall([&] { testCase.serialize(data); });
+            p.deserializeNs = timePerCall([&] { testCase.deserialize(input, res); });
+            measured.push_back(p);
+        }
+        if (measured.size() < 2) {
+            std::cout << "* micro " << name << ": not enough sizes fit in output buffer" << std::endl;
+            continue;
+        }
+        const auto& first = measured.front();
+        const auto& last = measured.back();
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(2) << "* micro " << name << ": serialize " << first.serializeNs
+             << " ns + " << costPerByte(measured, &Point::serializeNs) << " ns/B, deserialize "
+             << first.deserializeNs << " ns + " << costPerByte(measured, &Point::deserializeNs)
+             << " ns/B (" << std::setprecision(1) << (last.bytes - first.bytes) /
+             static_cast<double>(ELEMENT_COUNTS[measured.size() - 1] - ELEMENT_COUNTS[0]) << " B/element)";
+        std::cout << line.str() << std::endl;
+    }
+}
@@ -0,0 +1,212 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+    void eventConfig(PerfCounter counter, perf_event_attr& attr) {
+        auto cacheMiss = [&attr](uint64_t cache) {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        switch (counter) {
+            case PerfCounter::CYCLES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfCounter::INSTRUCTIONS:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfCounter::BRANCH_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case PerfCounter::L1D_MISSES:
+                cacheMiss(PERF_COUNT_HW_CACHE_L1D);
+                break;
+            case PerfCounter::LLC_MISSES:
+                cacheMiss(PERF_COUNT_HW_CACHE_LL);
+                break;
+            case PerfCounter::DTLB_MISSES:
+                cacheMiss(PERF_COUNT_HW_CACHE_DTLB);
+                break;
+            case PerfCounter::COUNT:
+                break;
+        }
+    }
+
+}
+
+PerfCounters::PerfCounters() {
+    open(_groups[0], {PerfCounter::CYCLES, PerfCounter::INSTRUCTIONS, PerfCounter::BRANCH_MISSES});
+    open(_groups[1], {PerfCounter::L1D_MISSES, PerfCounter::LLC_MISSES, PerfCounter::DTLB_MISSES});
+    if (available())
+        _error.clear();
+}
+
+PerfCounters::~PerfCounters() {
+    for (auto& g: _groups)
+        for (auto& e: g.events)
+            close(e.second);
+}
+
+void PerfCounters::open(Group& group, std::initializer_list<PerfCounter> counters) {
+    for (auto counter: counters) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        eventConfig(counter, attr);
+        attr.disabled = group.leaderFd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group.leaderFd, 0));
+        if (fd == -1) {
+            //unsupported event is skipped, remaining events are still measured
+            _error = std::string{"perf_event_open failed: "} + std::strerror(errno);
+            continue;
+        }
+        if (group.leaderFd == -1)
+            group.leaderFd = fd;
+        group.events.emplace_back(counter, fd);
+    }
+}
+
+bool PerfCounters::available() const {
+    return _groups[0].leaderFd != -1 || _groups[1].leaderFd != -1;
+}
+
+void PerfCounters::start() {
+    for (auto& g: _groups) {
+        if (g.leaderFd == -1)
+            continue;
+        ioctl(g.leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(g.leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+PerfValues PerfCounters::stop() {
+    for (auto& g: _groups)
+        if (g.leaderFd != -1)
+            ioctl(g.leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    PerfValues res{};
+    res.values.fill(-1.0);
+    for (auto& g: _groups) {
+        if (g.leaderFd == -1)
+            continue;
+        //layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+        uint64_t data[3 + static_cast<size_t>(PerfCounter::COUNT)]{};
+        if (read(g.leaderFd, data, sizeof(data)) <= 0 || data[2] == 0)
+            continue;
+        const auto scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        for (size_t i = 0; i < g.events.size() && i < data[0]; ++i)
+            res.values[static_cast<size_t>(g.events[i].first)] = static_cast<double>(data[3 + i]) * scale;
+    }
+    return res;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+    : _error{"perf_event_open is only available on linux"} {
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::open(Group&, std::initializer_list<PerfCounter>) {
+}
+
+bool PerfCounters::available() const {
+    return false;
+}
+
+void PerfCounters::start() {
+}
+
+PerfValues PerfCounters::stop() {
+    PerfValues res{};
+    res.values.fill(-1.0);
+    return res;
+}
+
+#endif
+
+const std::string& PerfCounters::error() const {
+    return _error;
+}
+
+std::string getPerfCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::CYCLES:
+            return "cycles";
+        case PerfCounter::INSTRUCTIONS:
+            return "instructions";
+        case PerfCounter::BRANCH_MISSES:
+            return "branch-misses";
+        case PerfCounter::L1D_MISSES:
+            return "L1d-misses";
+        case PerfCounter::LLC_MISSES:
+            return "LLC-misses";
+        case PerfCounter::DTLB_MISSES:
+            return "dTLB-misses";
+        case PerfCounter::COUNT:
+            break;
+    }
+    throw "Unknown perf counter";
+}
+
+void printPerfValues(const std::string& label, const PerfValues& values, size_t ops, size_t bytesPerOp) {
+    auto print = [&](const std::string& suffix, double divisor, int precision) {
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(precision) << "* " << label << suffix << ":";
+        for (size_t i = 0; i < values.values.size(); ++i) {
+            line << " " << getPerfCounterName(static_cast<PerfCounter>(i)) << " ";
+            if (values.values[i] < 0)
+                line << "n/a";
+            else
+                line << values.values[i] / divisor;
+        }
+        std::cout << line.str() << std::endl;
+    };
+    const auto opsCount = static_cast<double>(ops);
+    print(" counters/op  ", opsCount, 1);
+    print(" counters/byte", opsCount * static_cast<double>(bytesPerOp), 4);
+    const auto cycles = values[PerfCounter::CYCLES];
+    const auto instructions = values[PerfCounter::INSTRUCTIONS];
+    if (cycles > 0 && instructions >= 0)
+        std::cout << "* " << label << " ipc          : " << std::fixed << std::setprecision(2)
+                  << instructions / cycles << std::defaultfloat << std::setprecision(6) << std::endl;
+}
@@ -0,0 +1,83 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_PERF_COUNTERS_H
+#define CPP_SERIALIZERS_BENCHMARK_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class PerfCounter {
+    CYCLES,
+    INSTRUCTIONS,
+    BRANCH_MISSES,
+    L1D_MISSES,
+    LLC_MISSES,
+    DTLB_MISSES,
+    COUNT
+};
+
+struct PerfValues {
+    //negative value means that counter is not available
+    std::array<double, static_cast<size_t>(PerfCounter::COUNT)> values{};
+
+    double operator[](PerfCounter c) const {
+        return values[static_cast<size_t>(c)];
+    }
+};
+
+//hardware performance counters for calling thread using perf_event_open.
+//counters are opened in two groups, so that each group fits in available PMU registers,
+//values are scaled by enabled/running time if kernel had to multiplex them.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    //false when kernel forbids counters or platform doesn't support them, reason is in error()
+    bool available() const;
+    const std::string& error() const;
+
+    void start();
+    PerfValues stop();
+
+private:
+    struct Group {
+        int leaderFd{-1};
+        std::vector<std::pair<PerfCounter, int>> events{};
+    };
+
+    void open(Group& group, std::initializer_list<PerfCounter> counters);
+
+    std::array<Group, 2> _groups{};
+    std::string _error{};
+};
+
+std::string getPerfCounterName(PerfCounter);
+//prints counters per operation and per serialized byte, plus instructions per cycle
+void printPerfValues(const std::string& label, const PerfValues& values, size_t ops, size_t bytesPerOp);
+
+#endif //CPP_SERIALIZERS_BENCHMARK_PERF_COUNTERS_H
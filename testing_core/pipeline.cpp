@@ -0,0 +1,118 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "spsc_ring.h"
+#include "statistics.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+    struct PipelineMessage {
+        std::vector<uint8_t> bytes;
+        size_t bytesCount;
+        BenchClock::time_point created;
+    };
+
+    void pinThread(const char* role, long cpu) {
+        if (cpu < 0)
+            return;
+        std::string error{};
+        if (!pinToCpu(static_cast<size_t>(cpu), error))
+            std::cout << "* pipeline: cannot pin " << role << " to cpu " << cpu << ": " << error << std::endl;
+    }
+
+}
+
+void runPipelineBenchmark(const TestFactory& factory, const std::vector<MyTypes::Monster>& data,
+                          size_t messages, size_t slots, long producerCpu, long consumerCpu) {
+    if (!factory) {
+        std::cout << "* pipeline: skipped, test doesn't provide factory" << std::endl;
+        return;
+    }
+    SpscRing<PipelineMessage> ring{std::max<size_t>(1, slots)};
+    std::atomic<bool> failed{false};
+    LatencyHistogram latency{};
+    BenchClock::time_point start{};
+    BenchClock::time_point end{};
+
+    //producer and consumer have their own test instances, they might keep state between calls
+    std::thread consumer{[&] {
+        pinThread("consumer", consumerCpu);
+        auto testCase = factory();
+        std::vector<MyTypes::Monster> res{};
+        for (size_t i = 0; i < messages; ++i) {
+            PipelineMessage* msg;
+            while (!(msg = ring.tryPeek()))
+                std::this_thread::yield();
+            //deserialize on top of old object, same as default measurement
+            if (msg->bytesCount == 0)
+                failed = true;
+            else
+                testCase->deserialize(Buf{msg->bytes.data(), msg->bytesCount}, res);
+            const auto created = msg->created;
+            ring.release();
+            const auto now = BenchClock::now();
+            latency.record(elapsedNs(created, now));
+            if (i == 0 && res != data)
+                failed = true;
+            if (i + 1 == messages)
+                end = now;
+        }
+    }};
+    std::thread producer{[&] {
+        pinThread("producer", producerCpu);
+        auto testCase = factory();
+        //every message is same data, so slot capacity is known in advance;
+        //tests with unchecked writing accept sink only if their upper bound fits
+        const auto slotCapacity = std::max(MyTypes::serializedSizeUpperBound(data),
+                                           testCase->serialize(data).bytesCount);
+        start = BenchClock::now();
+        for (size_t i = 0; i < messages; ++i) {
+            PipelineMessage* msg;
+            while (!(msg = ring.tryAcquire()))
+                std::this_thread::yield();
+            msg->created = BenchClock::now();
+            //slot buffers are allocated on first use only, then serialize directly into slot
+            if (msg->bytes.size() < slotCapacity)
+                msg->bytes.resize(slotCapacity);
+            msg->bytesCount = testCase->serializeInto(data, {msg->bytes.data(), msg->bytes.size()});
+            ring.publish();
+        }
+    }};
+    producer.join();
+    consumer.join();
+
+    if (failed) {
+        std::cout << "* pipeline: result != data, abort." << std::endl;
+        return;
+    }
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(0) << "* pipeline   : " << slots << " slots, "
+         << static_cast<double>(messages) * 1e9 / static_cast<double>(elapsedNs(start, end)) << " messages/s";
+    std::cout << line.str() << std::endl;
+    printLatency("pipeline latency", latency);
+}
@@ -0,0 +1,254 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    //spin before sleeping on futex, so that busy transport doesn't make syscall for every message
+    constexpr size_t SPIN_COUNT = 1000;
+    //sleeping side wakes up this often to check that other process is still running
+    constexpr long PEER_CHECK_NS = 100000000;
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex needs lock-free 32bit atomics");
+
+    //futex operations are not private, because words are shared between processes
+    //returns true if wait timed out
+    bool futexWait(std::atomic<uint32_t>& word, uint32_t expected, const timespec& timeout) {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0) != 0
+               && errno == ETIMEDOUT;
+    }
+
+    void futexWake(std::atomic<uint32_t>& word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+
+    //counter that one process increments and other process waits for
+    struct alignas(CACHE_LINE_SIZE) SharedCounter {
+        std::atomic<uint32_t> value;
+        std::atomic<uint32_t> sleeping;
+
+        void increment() {
+            value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+            //seq_cst store above and load below pair with waiter's sleeping store and value load,
+            //so either waiter sees new value, or this side sees that waiter sleeps
+            if (sleeping.load(std::memory_order_seq_cst))
+                futexWake(value);
+        }
+
+        //waits until pred(value) is true, returns false if peerAlive reports that other process has exited
+        template<typename Pred, typename PeerAlive>
+        bool waitFor(Pred&& pred, PeerAlive&& peerAlive) {
+            for (size_t i = 0; i < SPIN_COUNT; ++i) {
+                if (pred(value.load(std::memory_order_acquire)))
+                    return true;
+            }
+            const timespec timeout{0, PEER_CHECK_NS};
+            sleeping.store(1, std::memory_order_seq_cst);
+            auto v = value.load(std::memory_order_seq_cst);
+            while (!pred(v)) {
+                //peer might have updated value right before exiting, so value is checked once more
+                if (futexWait(value, v, timeout) && !peerAlive() && !pred(value.load(std::memory_order_seq_cst))) {
+                    sleeping.store(0, std::memory_order_relaxed);
+                    return false;
+                }
+                v = value.load(std::memory_order_seq_cst);
+            }
+            sleeping.store(0, std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    struct SlotHeader {
+        uint64_t bytesCount;
+        BenchClock::time_point created;
+    };
+
+    //placed at the beginning of shared memory, followed by slots
+    struct RingHeader {
+        //written by writer process
+        SharedCounter published;
+        //written by reader process
+        SharedCounter consumed;
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> failed;
+    };
+
+    size_t alignToCacheLine(size_t size) {
+        return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    }
+
+    class SharedMemory {
+    public:
+        bool create(size_t size, std::string& error) {
+            //name is removed right after mapping, mapping stays valid and is inherited by forked process
+            const auto name = "/cpp_serializers_benchmark_" + std::to_string(getpid());
+            auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                error = std::string{"shm_open: "} + std::strerror(errno);
+                return false;
+            }
+            shm_unlink(name.c_str());
+            if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                error = std::string{"ftruncate: "} + std::strerror(errno);
+                close(fd);
+                return false;
+            }
+            auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (ptr == MAP_FAILED) {
+                error = std::string{"mmap: "} + std::strerror(errno);
+                return false;
+            }
+            _ptr = static_cast<uint8_t*>(ptr);
+            _size = size;
+            return true;
+        }
+
+        uint8_t* data() const {
+            return _ptr;
+        }
+
+        ~SharedMemory() {
+            if (_ptr)
+                munmap(_ptr, _size);
+        }
+
+    private:
+        uint8_t* _ptr{};
+        size_t _size{};
+    };
+
+}
+
+void runShmBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages,
+                     size_t slots) {
+    slots = std::max<size_t>(1, slots);
+    //every message is same data, so its size is known in advance;
+    //tests with unchecked writing accept sink only if their upper bound fits
+    const auto slotSize = alignToCacheLine(sizeof(SlotHeader) + std::max(MyTypes::serializedSizeUpperBound(data),
+                                                                          testCase.serialize(data).bytesCount));
+    const auto headerSize = alignToCacheLine(sizeof(RingHeader));
+
+    SharedMemory shm{};
+    std::string error{};
+    if (!shm.create(headerSize + slots * slotSize, error)) {
+        std::cout << "* shm: unavailable, " << error << std::endl;
+        return;
+    }
+    auto ring = new(shm.data()) RingHeader{};
+    auto slot = [&](uint32_t index) {
+        return shm.data() + headerSize + (index % slots) * slotSize;
+    };
+
+    std::cout.flush();
+    const auto reader = getpid();
+    const auto writer = fork();
+    if (writer < 0) {
+        std::cout << "* shm: unavailable, fork: " << std::strerror(errno) << std::endl;
+        return;
+    }
+    if (writer == 0) {
+        //writer process, uses its copy of test instance
+        auto readerAlive = [reader]() { return getppid() == reader; };
+        for (uint32_t i = 0; i < messages; ++i) {
+            if (!ring->consumed.waitFor([&](uint32_t consumed) { return i - consumed < slots; }, readerAlive))
+                _exit(1);
+            auto s = slot(i);
+            SlotHeader header{0, BenchClock::now()};
+            //serialize directly into slot, so that transport adds no copy
+            header.bytesCount = testCase.serializeInto(data, {s + sizeof(SlotHeader), slotSize - sizeof(SlotHeader)});
+            if (header.bytesCount == 0)
+                ring->failed = 1;
+            std::memcpy(s, &header, sizeof(header));
+            ring->published.increment();
+        }
+        _exit(0);
+    }
+
+    //reader process
+    int status{};
+    bool writerExited{false};
+    auto writerAlive = [&]() {
+        if (!writerExited && waitpid(writer, &status, WNOHANG) == writer)
+            writerExited = true;
+        return !writerExited;
+    };
+    LatencyHistogram latency{};
+    std::vector<MyTypes::Monster> res{};
+    double bytes{};
+    const auto start = BenchClock::now();
+    for (uint32_t i = 0; i < messages; ++i) {
+        if (!ring->published.waitFor([&](uint32_t published) { return published != i; }, writerAlive)) {
+            std::cout << "* shm: writer process exited early, abort." << std::endl;
+            return;
+        }
+        auto s = slot(i);
+        SlotHeader header{};
+        std::memcpy(&header, s, sizeof(header));
+        bytes += static_cast<double>(header.bytesCount);
+        //deserialize on top of old object, same as default measurement
+        testCase.deserialize(Buf{s + sizeof(SlotHeader), header.bytesCount}, res);
+        ring->consumed.increment();
+        latency.record(elapsedNs(header.created, BenchClock::now()));
+        if (i == 0 && res != data)
+            ring->failed = 1;
+    }
+    const auto ns = static_cast<double>(elapsedNs(start, BenchClock::now()));
+    if (!writerExited)
+        waitpid(writer, &status, 0);
+
+    if (ring->failed) {
+        std::cout << "* shm: result != data, abort." << std::endl;
+        return;
+    }
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(0) << "* shm        : " << slots << " slots, "
+         << static_cast<double>(messages) * 1e9 / ns << " messages/s, " << std::setprecision(1)
+         << bytes * 1e3 / ns << " MB/s";
+    std::cout << line.str() << std::endl;
+    printLatency("shm latency", latency);
+}
+
+#else
+
+void runShmBenchmark(ISerializerTest&, const std::vector<MyTypes::Monster>&, size_t, size_t) {
+    std::cout << "* shm: unavailable, only implemented on linux" << std::endl;
+}
+
+#endif
@@ -0,0 +1,71 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+void runSinkBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t samples) {
+    const auto buf = testCase.serialize(data);
+    //spare room, so implementations that check remaining space with upper bound still fit
+    std::vector<uint8_t> sinkMemory(2 * buf.bytesCount + 4096);
+    const OutputSink sink{sinkMemory.data(), sinkMemory.size()};
+
+    const auto written = testCase.serializeInto(data, sink);
+    if (written == 0) {
+        std::cout << "* sink: serializeInto failed, abort." << std::endl;
+        return;
+    }
+    std::vector<MyTypes::Monster> res{};
+    testCase.deserialize(Buf{sink.ptr, written}, res);
+    if (res != data) {
+        std::cout << "* sink: deserialized data from sink != data, abort." << std::endl;
+        return;
+    }
+
+    //serialize into test's own buffer only, lower bound of what sink can achieve
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.serialize(data);
+    const auto serializeNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    //what caller has to do without serializeInto
+    start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        const auto out = testCase.serialize(data);
+        std::memcpy(sink.ptr, out.ptr, out.bytesCount);
+    }
+    const auto copyNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.serializeInto(data, sink);
+    const auto intoNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    const auto n = static_cast<double>(samples);
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* sink       : serialize " << serializeNs / n
+         << " ns/call, serialize+copy " << copyNs / n << " ns/call, serializeInto " << intoNs / n
+         << " ns/call (" << copyNs / intoNs << "x)";
+    std::cout << line.str() << std::endl;
+}
@@ -0,0 +1,205 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "io_utils.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    //every message is prefixed by this frame header
+    struct FrameHeader {
+        uint64_t bytesCount;
+        BenchClock::time_point created;
+    };
+
+    std::string errnoMessage(const char* call) {
+        return std::string{call} + ": " + std::strerror(errno);
+    }
+
+    class Socket {
+    public:
+        Socket() = default;
+        explicit Socket(int fd)
+            : _fd{fd} {
+        }
+        Socket(Socket&& other) noexcept
+            : _fd{std::exchange(other._fd, -1)} {
+        }
+        Socket& operator=(Socket&& other) noexcept {
+            std::swap(_fd, other._fd);
+            return *this;
+        }
+        ~Socket() {
+            if (_fd >= 0)
+                close(_fd);
+        }
+        int fd() const {
+            return _fd;
+        }
+    private:
+        int _fd{-1};
+    };
+
+    bool writeFrame(int fd, FrameHeader header, Buf buf) {
+        iovec parts[2] = {
+            {&header, sizeof(header)},
+            {const_cast<uint8_t*>(buf.ptr), buf.bytesCount},
+        };
+        return writeAll(fd, parts, 2);
+    }
+
+    void setNoDelay(int fd) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    //connected sender and receiver sockets
+    bool connectUnix(Socket& sender, Socket& receiver, std::string& error) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            error = errnoMessage("socketpair");
+            return false;
+        }
+        sender = Socket{fds[0]};
+        receiver = Socket{fds[1]};
+        return true;
+    }
+
+    bool connectTcp(Socket& sender, Socket& receiver, std::string& error) {
+        Socket listener{socket(AF_INET, SOCK_STREAM, 0)};
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        //port 0 lets the kernel pick free port
+        addr.sin_port = 0;
+        socklen_t addrLen = sizeof(addr);
+        if (listener.fd() < 0 || bind(listener.fd(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            listen(listener.fd(), 1) != 0 ||
+            getsockname(listener.fd(), reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0) {
+            error = errnoMessage("listen");
+            return false;
+        }
+        sender = Socket{socket(AF_INET, SOCK_STREAM, 0)};
+        if (sender.fd() < 0 || connect(sender.fd(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            error = errnoMessage("connect");
+            return false;
+        }
+        receiver = Socket{accept(listener.fd(), nullptr, nullptr)};
+        if (receiver.fd() < 0) {
+            error = errnoMessage("accept");
+            return false;
+        }
+        setNoDelay(sender.fd());
+        setNoDelay(receiver.fd());
+        return true;
+    }
+
+}
+
+void runSocketBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, size_t messages,
+                        bool tcp) {
+    const char* name = tcp ? "tcp" : "unix";
+    Socket sender{};
+    Socket receiver{};
+    std::string error{};
+    if (!(tcp ? connectTcp(sender, receiver, error) : connectUnix(sender, receiver, error))) {
+        std::cout << "* socket " << name << ": unavailable, " << error << std::endl;
+        return;
+    }
+
+    std::cout.flush();
+    const auto senderPid = fork();
+    if (senderPid < 0) {
+        std::cout << "* socket " << name << ": unavailable, " << errnoMessage("fork") << std::endl;
+        return;
+    }
+    if (senderPid == 0) {
+        //sender process, uses its copy of test instance
+        receiver = Socket{};
+        for (size_t i = 0; i < messages; ++i) {
+            FrameHeader header{0, BenchClock::now()};
+            auto buf = testCase.serialize(data);
+            header.bytesCount = buf.bytesCount;
+            if (!writeFrame(sender.fd(), header, buf))
+                _exit(1);
+        }
+        _exit(0);
+    }
+
+    //receiver process
+    sender = Socket{};
+    LatencyHistogram latency{};
+    std::vector<uint8_t> payload{};
+    std::vector<MyTypes::Monster> res{};
+    double bytes{};
+    bool failed = false;
+    const auto start = BenchClock::now();
+    for (size_t i = 0; i < messages && !failed; ++i) {
+        FrameHeader header{};
+        if (!readExact(receiver.fd(), &header, sizeof(header)))
+            break;
+        payload.resize(header.bytesCount);
+        if (!readExact(receiver.fd(), payload.data(), payload.size()))
+            break;
+        //deserialize on top of old object, same as default measurement
+        testCase.deserialize(Buf{payload.data(), payload.size()}, res);
+        latency.record(elapsedNs(header.created, BenchClock::now()));
+        bytes += static_cast<double>(sizeof(header) + header.bytesCount);
+        failed = i == 0 && res != data;
+    }
+    const auto ns = static_cast<double>(elapsedNs(start, BenchClock::now()));
+    receiver = Socket{};
+    int status{};
+    waitpid(senderPid, &status, 0);
+
+    if (failed || latency.count() != messages) {
+        std::cout << "* socket " << name << ": " << (failed ? "result != data" : "connection closed")
+                  << ", abort." << std::endl;
+        return;
+    }
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(0) << "* socket " << name << ": "
+         << static_cast<double>(messages) * 1e9 / ns << " messages/s, " << std::setprecision(1)
+         << bytes * 1e3 / ns << " MB/s";
+    std::cout << line.str() << std::endl;
+    printLatency(std::string{"socket "} + name + " latency", latency);
+}
+
+#else
+
+void runSocketBenchmark(ISerializerTest&, const std::vector<MyTypes::Monster>&, size_t, bool tcp) {
+    std::cout << "* socket " << (tcp ? "tcp" : "unix") << ": unavailable, only implemented on linux" << std::endl;
+}
+
+#endif
@@ -0,0 +1,83 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_SPSC_RING_H
+#define CPP_SERIALIZERS_BENCHMARK_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+//lock-free ring for exactly one producer and one consumer thread.
+//slots are preallocated and reused, producer fills a slot in place and publishes it, consumer reads it in place and
+//releases it, so that no allocation or copy of slot object happens on hand-off
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : _slots(capacity) {
+    }
+
+    //producer: slot to fill, or nullptr if ring is full
+    T* tryAcquire() {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead == _slots.size()) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead == _slots.size())
+                return nullptr;
+        }
+        return &_slots[tail % _slots.size()];
+    }
+
+    //producer: make slot returned by tryAcquire visible to consumer
+    void publish() {
+        _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //consumer: oldest published slot, or nullptr if ring is empty
+    T* tryPeek() {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail)
+                return nullptr;
+        }
+        return &_slots[head % _slots.size()];
+    }
+
+    //consumer: give slot returned by tryPeek back to producer
+    void release() {
+        _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> _slots;
+    //producer and consumer indices are on separate cache lines, each side also caches the other's index
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+    size_t _cachedHead{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{0};
+    size_t _cachedTail{0};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_SPSC_RING_H
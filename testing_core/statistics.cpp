@@ -0,0 +1,105 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "statistics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <cstring>
+#endif
+
+namespace {
+
+    //linear interpolation between closest ranks, values must be sorted
+    double quantile(const std::vector<double>& sorted, double q) {
+        const auto pos = q * static_cast<double>(sorted.size() - 1);
+        const auto lo = static_cast<size_t>(std::floor(pos));
+        const auto hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - static_cast<double>(lo));
+    }
+
+}
+
+TrialStats summarizeTrials(std::vector<double> nsPerCall) {
+    TrialStats res{};
+    if (nsPerCall.empty())
+        return res;
+    std::sort(nsPerCall.begin(), nsPerCall.end());
+    const auto q1 = quantile(nsPerCall, 0.25);
+    const auto q3 = quantile(nsPerCall, 0.75);
+    const auto iqr = q3 - q1;
+    std::vector<double> kept{};
+    std::copy_if(nsPerCall.begin(), nsPerCall.end(), std::back_inserter(kept), [=](double v) {
+        return v >= q1 - 1.5 * iqr && v <= q3 + 1.5 * iqr;
+    });
+    res.trials = kept.size();
+    res.outliers = nsPerCall.size() - kept.size();
+    res.median = quantile(kept, 0.5);
+
+    //ranks of order statistics that bound the median with 95% confidence, normal approximation of binomial(n, 0.5)
+    const auto n = static_cast<double>(kept.size());
+    const auto halfWidth = 1.96 * std::sqrt(n) / 2.0;
+    const auto lo = static_cast<long>(std::floor(n / 2.0 - halfWidth)) - 1;
+    const auto hi = static_cast<long>(std::ceil(n / 2.0 + halfWidth));
+    res.ciLow = kept[static_cast<size_t>(std::clamp(lo, 0l, static_cast<long>(kept.size()) - 1))];
+    res.ciHigh = kept[static_cast<size_t>(std::clamp(hi, 0l, static_cast<long>(kept.size()) - 1))];
+    return res;
+}
+
+bool isStable(const std::vector<double>& batches, size_t window, double tolerance) {
+    if (batches.size() < window)
+        return false;
+    auto [min, max] = std::minmax_element(batches.end() - static_cast<std::ptrdiff_t>(window), batches.end());
+    return (*max - *min) / *min <= tolerance;
+}
+
+bool pinToCpu(size_t cpu, std::string& error) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    (void) cpu;
+    error = "cpu pinning is only implemented on linux";
+    return false;
+#endif
+}
+
+void printTrialStats(const std::string& label, const TrialStats& stats) {
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* " << label << " trials : median " << stats.median
+         << " ns/op, 95% CI [" << stats.ciLow << ", " << stats.ciHigh << "], "
+         << stats.trials << " trials, " << stats.outliers << " outliers rejected, warmup "
+         << stats.warmupBatches << " batches" << (stats.stable ? "" : " (not stable)");
+    std::cout << line.str() << std::endl;
+}
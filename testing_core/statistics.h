@@ -0,0 +1,93 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_STATISTICS_H
+#define CPP_SERIALIZERS_BENCHMARK_STATISTICS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "benchmarks.h"
+#include "perf_counters.h"
+
+struct TrialStats {
+    //all values are nanoseconds per call
+    double median;
+    double ciLow;
+    double ciHigh;
+    size_t trials;
+    size_t outliers;
+    size_t warmupBatches;
+    bool stable;
+    //counters for all measured trials, when requested
+    PerfValues perf;
+};
+
+//rejects outliers outside Tukey fences (1.5 IQR) and computes median with
+//distribution free 95% confidence interval from order statistics
+TrialStats summarizeTrials(std::vector<double> nsPerCall);
+
+//true when relative spread of last `window` batch times is within tolerance
+bool isStable(const std::vector<double>& batches, size_t window, double tolerance);
+
+bool pinToCpu(size_t cpu, std::string& error);
+
+void printTrialStats(const std::string& label, const TrialStats& stats);
+
+//runs `op` in batches until timings stabilize, then measures `trials` independent trials of `samples` calls
+template<typename Op>
+TrialStats runTrials(Op&& op, size_t trials, size_t samples, double warmupTolerance, PerfCounters* perf = nullptr) {
+    constexpr size_t WINDOW = 5;
+    constexpr size_t MAX_WARMUP_BATCHES = 100;
+    auto timeCalls = [&op](size_t count) {
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < count; ++i)
+            op();
+        return static_cast<double>(elapsedNs(start, BenchClock::now())) / static_cast<double>(count);
+    };
+
+    const auto batchSize = std::max<size_t>(1, samples / 10);
+    std::vector<double> batches{};
+    bool stable = false;
+    while (!stable && batches.size() < MAX_WARMUP_BATCHES) {
+        batches.push_back(timeCalls(batchSize));
+        stable = isStable(batches, WINDOW, warmupTolerance);
+    }
+
+    std::vector<double> results{};
+    results.reserve(trials);
+    if (perf)
+        perf->start();
+    for (size_t i = 0; i < trials; ++i)
+        results.push_back(timeCalls(samples));
+    PerfValues perfValues{};
+    if (perf)
+        perfValues = perf->stop();
+    auto res = summarizeTrials(std::move(results));
+    res.perf = perfValues;
+    res.warmupBatches = batches.size();
+    res.stable = stable;
+    return res;
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_STATISTICS_H
@@ -0,0 +1,90 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "benchmarks.h"
+#include "cache_info.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+void runSizeSweep(ISerializerTest& testCase, MyTypes::WorkloadProfile profile, uint32_t seed,
+                  size_t bytesPerMonster, size_t maxMonsters, size_t bytesPerSize, size_t generatorThreads) {
+    if (maxMonsters == 0) {
+        //sweep until serialized data alone is twice as big as last level cache
+        maxMonsters = 2 * lastLevelCacheSize() / std::max<size_t>(1, bytesPerMonster);
+        std::cout << "* sweep      : last level cache " << (lastLevelCacheSize() >> 10) << "KiB, up to "
+                  << maxMonsters << " monsters" << std::endl;
+    }
+    std::vector<MyTypes::Monster> res{};
+    //sizes that might not fit in test's own output buffer are serialized into this one with serializeInto
+    std::vector<uint8_t> scratch{};
+    for (size_t count = 1;; count = std::min(count * 4, maxMonsters)) {
+        const auto data = MyTypes::createMonstersParallel(count, profile, seed, generatorThreads);
+        const auto upperBound = MyTypes::serializedSizeUpperBound(data);
+        const bool intoScratch = upperBound > testCase.bufferCapacity();
+        if (intoScratch)
+            scratch.resize(upperBound);
+        auto serialize = [&]() {
+            if (!intoScratch)
+                return testCase.serialize(data);
+            return Buf{scratch.data(), testCase.serializeInto(data, OutputSink{scratch.data(), scratch.size()})};
+        };
+        auto buf = serialize();
+        if (buf.bytesCount == 0) {
+            std::cout << "* sweep " << count << " monsters: doesn't fit in " << upperBound
+                      << "B output buffer, abort." << std::endl;
+            return;
+        }
+        testCase.deserialize(buf, res);
+        if (res != data) {
+            std::cout << "* sweep " << count << " monsters: result != data, abort." << std::endl;
+            return;
+        }
+        //same amount of bytes is processed for each size, but at least few calls
+        const auto iterations = std::max<size_t>(3, bytesPerSize / std::max<size_t>(1, buf.bytesCount));
+
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            serialize();
+        const auto serNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+        //deserialize on top of old object, same as default measurement
+        start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            testCase.deserialize(buf, res);
+        const auto desNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+        const auto monsters = static_cast<double>(count * iterations);
+        //bytes per nanosecond * 1000 = MB/s
+        const auto bytes = static_cast<double>(buf.bytesCount * iterations) * 1e3;
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(1)
+             << "* sweep " << count << " monsters (" << buf.bytesCount << "B): ser "
+             << serNs / monsters << " ns/monster " << bytes / serNs << " MB/s, des "
+             << desNs / monsters << " ns/monster " << bytes / desNs << " MB/s";
+        if (intoScratch)
+            line << ", serializeInto";
+        std::cout << line.str() << std::endl;
+        if (count >= maxMonsters)
+            return;
+    }
+}
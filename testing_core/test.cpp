@@ -22,21 +22,50 @@
 
 
 #include <testing/test.h>
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <thread>
+#include "benchmarks.h"
+#include "environment.h"
+#include "perf_counters.h"
+#include "statistics.h"
 
 static constexpr int MONSTERS_COUNT = MONSTERS;
 static constexpr int SAMPLES_COUNT = SAMPLES;
 
 
-int runTest(ISerializerTest& testCase) {
+int runTest(ISerializerTest& testCase, const TestFactory& factory) {
     //test
     auto info = testCase.testInfo();
     std::cout << std::endl << "* TEST: " << getLibraryName(info.library) << std::endl;
     std::cout << "* name       : " << info.name << std::endl;
     std::cout << "* info       : " << info.info << std::endl;
 
-    const std::vector<MyTypes::Monster>& data = MyTypes::createMonsters(MONSTERS_COUNT);
+    if (!getEnvString("BENCH_CPU").empty()) {
+        std::string error{};
+        const auto cpu = getEnvSize("BENCH_CPU", 0);
+        if (pinToCpu(cpu, error))
+            std::cout << "* pinned to cpu " << cpu << std::endl;
+        else
+            std::cout << "* cannot pin to cpu " << cpu << ": " << error << std::endl;
+    }
+
+    auto profile = MyTypes::WorkloadProfile::DEFAULT;
+    const auto profileName = getEnvString("BENCH_PROFILE", MyTypes::getWorkloadProfileName(profile));
+    if (!MyTypes::parseWorkloadProfile(profileName, profile)) {
+        std::cout << "unknown workload profile '" << profileName << "', abort." << std::endl;
+        return -1;
+    }
+    const auto seed = static_cast<uint32_t>(getEnvSize("BENCH_SEED", 0));
+    if (profile != MyTypes::WorkloadProfile::DEFAULT || seed != 0)
+        std::cout << "* profile    : " << profileName << ", seed " << seed << std::endl;
+
+    const std::vector<MyTypes::Monster>& data = MyTypes::createMonsters(MONSTERS_COUNT, profile, seed);
+    if (MyTypes::serializedSizeUpperBound(data) > testCase.bufferCapacity()) {
+        std::cout << "data might not fit in " << testCase.bufferCapacity() << "B output buffer, skip." << std::endl;
+        return 0;
+    }
     std::vector<MyTypes::Monster> res{};
     //warmup
     auto buf = testCase.serialize(data);
@@ -50,22 +79,129 @@ int runTest(ISerializerTest& testCase) {
     }
     std::cout << "* data size  : " << buf.bytesCount << std::endl;
 
-    //begin serialization
-    auto start = std::chrono::steady_clock::now();
-    for (auto i = 0; i < SAMPLES_COUNT; ++i)
-        testCase.serialize(data);
-    auto end = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    std::cout << "* serialize  : " << duration.count() / 1000 << std::endl;
+    //hardware counters are enabled only around measured loops
+    std::unique_ptr<PerfCounters> perf{};
+    PerfValues serPerf{};
+    PerfValues desPerf{};
+    if (getEnvFlag("BENCH_PERF"))
+        perf = std::make_unique<PerfCounters>();
 
-    //deserialize on top of old object
-    start = std::chrono::steady_clock::now();
-    for (auto i = 0; i < SAMPLES_COUNT; ++i) {
-        testCase.deserialize(buf, res);
+    size_t perfCalls = SAMPLES_COUNT;
+    const auto trials = getEnvSize("BENCH_TRIALS", 1);
+    if (trials > 1) {
+        const auto trialSamples = std::max<size_t>(1, getEnvSize("BENCH_TRIAL_SAMPLES", SAMPLES_COUNT / 10));
+        const auto tolerance = static_cast<double>(getEnvSize("BENCH_WARMUP_TOLERANCE", 5)) / 100.0;
+        //reported times are medians scaled to SAMPLES_COUNT calls, so they are comparable with single pass results
+        auto toMs = [](const TrialStats& stats) {
+            return static_cast<long long>(stats.median * SAMPLES_COUNT / 1e6);
+        };
+        auto serStats = runTrials([&] { testCase.serialize(data); }, trials, trialSamples, tolerance, perf.get());
+        std::cout << "* serialize  : " << toMs(serStats) << std::endl;
+        //deserialize on top of old object
+        auto desStats = runTrials([&] { testCase.deserialize(buf, res); }, trials, trialSamples, tolerance, perf.get());
+        std::cout << "* deserialize: " << toMs(desStats) << std::endl;
+        printTrialStats("ser", serStats);
+        printTrialStats("des", desStats);
+        serPerf = serStats.perf;
+        desPerf = desStats.perf;
+        perfCalls = trials * trialSamples;
+    } else {
+        //begin serialization
+        if (perf)
+            perf->start();
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < SAMPLES_COUNT; ++i)
+            testCase.serialize(data);
+        auto end = std::chrono::steady_clock::now();
+        if (perf)
+            serPerf = perf->stop();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "* serialize  : " << duration.count() / 1000 << std::endl;
+
+        //deserialize on top of old object
+        if (perf)
+            perf->start();
+        start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < SAMPLES_COUNT; ++i) {
+            testCase.deserialize(buf, res);
+        }
+        end = std::chrono::steady_clock::now();
+        if (perf)
+            desPerf = perf->stop();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "* deserialize: " << duration.count() / 1000 << std::endl;
+    }
+
+    if (perf && perf->available()) {
+        printPerfValues("ser", serPerf, perfCalls, buf.bytesCount);
+        printPerfValues("des", desPerf, perfCalls, buf.bytesCount);
+    } else if (perf) {
+        std::cout << "* perf counters: unavailable, " << perf->error() << std::endl;
+    }
+
+    if (getEnvFlag("BENCH_LATENCY"))
+        runLatencyBenchmark(testCase, data, buf, SAMPLES_COUNT);
+    if (getEnvFlag("BENCH_ALLOC"))
+        runAllocationBenchmark(testCase, data, buf, getEnvSize("BENCH_ALLOC_SAMPLES", 1000));
+    if (getEnvFlag("BENCH_DES_MODES"))
+        runDeserializeModes(testCase, buf, SAMPLES_COUNT);
+    if (getEnvFlag("BENCH_ACCESS"))
+        runAccessBenchmark(testCase, data, buf, getEnvSize("BENCH_ACCESS_SAMPLES", 10000));
+    if (getEnvFlag("BENCH_VIEW"))
+        runViewBenchmark(testCase, data, buf, SAMPLES_COUNT);
+    if (getEnvFlag("BENCH_COLD"))
+        runColdCacheBenchmark(testCase, data, buf, profile, seed, getEnvString("BENCH_COLD", ""),
+                              getEnvSize("BENCH_COLD_BYTES", 0), getEnvSize("BENCH_COLD_SAMPLES", 100));
+    if (getEnvFlag("BENCH_SWEEP"))
+        runSizeSweep(testCase, profile, seed, buf.bytesCount / MONSTERS_COUNT, getEnvSize("BENCH_SWEEP_MAX", 0),
+                     getEnvSize("BENCH_SWEEP_BYTES", 256u << 20), getEnvSize("BENCH_GEN_THREADS", 0));
+    if (getEnvFlag("BENCH_PIPELINE")) {
+        auto cpu = [](const char* name) {
+            return getEnvString(name).empty() ? -1L : static_cast<long>(getEnvSize(name, 0));
+        };
+        runPipelineBenchmark(factory, data, getEnvSize("BENCH_PIPELINE_MESSAGES", SAMPLES_COUNT / 10),
+                             getEnvSize("BENCH_PIPELINE_SLOTS", 64), cpu("BENCH_PRODUCER_CPU"),
+                             cpu("BENCH_CONSUMER_CPU"));
+    }
+    if (getEnvFlag("BENCH_SHM"))
+        runShmBenchmark(testCase, data, getEnvSize("BENCH_SHM_MESSAGES", SAMPLES_COUNT / 10),
+                        getEnvSize("BENCH_SHM_SLOTS", 64));
+    if (getEnvFlag("BENCH_SOCKET")) {
+        //"tcp", "unix" or any other value for both
+        const auto transport = getEnvString("BENCH_SOCKET");
+        const auto messages = getEnvSize("BENCH_SOCKET_MESSAGES", SAMPLES_COUNT / 10);
+        if (transport != "tcp")
+            runSocketBenchmark(testCase, data, messages, false);
+        if (transport != "unix")
+            runSocketBenchmark(testCase, data, messages, true);
+    }
+    if (getEnvFlag("BENCH_GATHER"))
+        runGatherBenchmark(testCase, data, SAMPLES_COUNT / 10);
+    if (getEnvFlag("BENCH_SINK"))
+        runSinkBenchmark(testCase, data, SAMPLES_COUNT / 10);
+    if (getEnvFlag("BENCH_MESSAGES"))
+        runMessageRateBenchmark(testCase, data, getEnvSize("BENCH_MESSAGES_COUNT", SAMPLES_COUNT));
+    if (getEnvFlag("BENCH_MICRO"))
+        runTypeMicrobenchmarks(testCase, seed);
+    if (getEnvFlag("BENCH_CHUNKED") || getEnvFlag("BENCH_CHUNKED_LOAD")) {
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        const auto monsters = getEnvSize("BENCH_CHUNKED_MONSTERS", 200000);
+        const auto chunkMonsters = getEnvSize("BENCH_CHUNK_MONSTERS", 2048);
+        const auto threads = getEnvSize("BENCH_CHUNKED_THREADS", cores);
+        const auto samples = getEnvSize("BENCH_CHUNKED_SAMPLES", 10);
+        if (getEnvFlag("BENCH_CHUNKED"))
+            runChunkedScaling(factory, profile, seed, monsters, chunkMonsters, threads, samples);
+        if (getEnvFlag("BENCH_CHUNKED_LOAD"))
+            runChunkedLoad(factory, profile, seed, monsters, chunkMonsters, threads, samples);
+    }
+    if (getEnvFlag("BENCH_ARENA"))
+        runArenaBenchmark(testCase, data, SAMPLES_COUNT / 10);
+    if (getEnvFlag("BENCH_THREADS")) {
+        //thread count or any other value for all available cores
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        runThroughputScaling(factory, data, getEnvSize("BENCH_THREADS", cores),
+                             getEnvSize("BENCH_THREAD_SAMPLES", SAMPLES_COUNT / 10));
     }
-    end = std::chrono::steady_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    std::cout << "* deserialize: " << duration.count() / 1000 << std::endl;
     return 0;
 }
 
@@ -0,0 +1,57 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_MEMORY_STREAM_H
+#define CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_MEMORY_STREAM_H
+
+#include <streambuf>
+#include <testing/test.h>
+
+//stream buffer that writes directly into OutputSink, used by stream based libraries to implement serializeInto.
+//when sink is full, writes fail and overflowed() returns true
+class MemoryStreamBuf : public std::streambuf {
+public:
+    explicit MemoryStreamBuf(OutputSink sink) {
+        auto begin = reinterpret_cast<char*>(sink.ptr);
+        setp(begin, begin + sink.capacity);
+    }
+
+    size_t written() const {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+    bool overflowed() const {
+        return _overflowed;
+    }
+
+protected:
+    int_type overflow(int_type) override {
+        _overflowed = true;
+        return traits_type::eof();
+    }
+
+private:
+    bool _overflowed{false};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_MEMORY_STREAM_H
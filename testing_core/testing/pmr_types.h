@@ -0,0 +1,131 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_PMR_TYPES_H
+#define CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_PMR_TYPES_H
+
+#include <algorithm>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <testing/types.h>
+
+//same types as in types.h, but strings and containers take memory from std::pmr::memory_resource.
+//types are allocator-aware, so memory resource of pmr::vector is passed to all its elements.
+//members are declared in the same order, so serializers that rely on member order read the same data
+namespace MyTypes::pmr {
+
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    struct Weapon {
+        using allocator_type = pmr::allocator_type;
+
+        std::pmr::string name;
+        int16_t damage{};
+
+        Weapon() = default;
+        explicit Weapon(allocator_type alloc)
+            : name{alloc} {
+        }
+        Weapon(const Weapon& other, allocator_type alloc)
+            : name{other.name, alloc},
+              damage{other.damage} {
+        }
+        Weapon(Weapon&& other, allocator_type alloc)
+            : name{std::move(other.name), alloc},
+              damage{other.damage} {
+        }
+        Weapon(const Weapon&) = default;
+        Weapon(Weapon&&) = default;
+        Weapon& operator=(const Weapon&) = default;
+        Weapon& operator=(Weapon&&) = default;
+    };
+
+    struct Monster {
+        using allocator_type = pmr::allocator_type;
+
+        Vec3 pos{};
+        int16_t mana{};
+        int16_t hp{};
+        std::pmr::string name;
+        std::pmr::vector<uint8_t> inventory;
+        Color color{};
+        std::pmr::vector<Weapon> weapons;
+        Weapon equipped;
+        std::pmr::vector<Vec3> path;
+
+        Monster() = default;
+        explicit Monster(allocator_type alloc)
+            : name{alloc},
+              inventory{alloc},
+              weapons{alloc},
+              equipped{alloc},
+              path{alloc} {
+        }
+        Monster(const Monster& other, allocator_type alloc)
+            : pos{other.pos},
+              mana{other.mana},
+              hp{other.hp},
+              name{other.name, alloc},
+              inventory{other.inventory, alloc},
+              color{other.color},
+              weapons{other.weapons, alloc},
+              equipped{other.equipped, alloc},
+              path{other.path, alloc} {
+        }
+        Monster(Monster&& other, allocator_type alloc)
+            : pos{other.pos},
+              mana{other.mana},
+              hp{other.hp},
+              name{std::move(other.name), alloc},
+              inventory{std::move(other.inventory), alloc},
+              color{other.color},
+              weapons{std::move(other.weapons), alloc},
+              equipped{std::move(other.equipped), alloc},
+              path{std::move(other.path), alloc} {
+        }
+        Monster(const Monster&) = default;
+        Monster(Monster&&) = default;
+        Monster& operator=(const Monster&) = default;
+        Monster& operator=(Monster&&) = default;
+    };
+
+    inline bool operator==(const Weapon& lhs, const MyTypes::Weapon& rhs) {
+        return std::string_view{lhs.name} == rhs.name && lhs.damage == rhs.damage;
+    }
+
+    inline bool operator==(const Monster& lhs, const MyTypes::Monster& rhs) {
+        return lhs.pos == rhs.pos &&
+               lhs.mana == rhs.mana &&
+               lhs.hp == rhs.hp &&
+               std::string_view{lhs.name} == rhs.name &&
+               std::equal(lhs.inventory.begin(), lhs.inventory.end(), rhs.inventory.begin(), rhs.inventory.end()) &&
+               lhs.color == rhs.color &&
+               std::equal(lhs.weapons.begin(), lhs.weapons.end(), rhs.weapons.begin(), rhs.weapons.end()) &&
+               lhs.equipped == rhs.equipped &&
+               std::equal(lhs.path.begin(), lhs.path.end(), rhs.path.begin(), rhs.path.end());
+    }
+
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_PMR_TYPES_H
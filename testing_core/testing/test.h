@@ -24,14 +24,28 @@
 #ifndef CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TEST_H
 #define CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TEST_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
 #include <testing/types.h>
+#include <testing/views.h>
+#include <testing/pmr_types.h>
 
 struct Buf {
     const uint8_t* ptr;
     size_t bytesCount;
 };
 
+//caller-owned memory to serialize into, e.g. socket buffer, mmap'ed file or shared memory slot
+struct OutputSink {
+    uint8_t* ptr;
+    size_t capacity;
+};
+
 enum class SerializationLibrary {
     BITSERY,
     BOOST,
@@ -56,10 +70,89 @@ public:
     virtual Buf serialize(const std::vector<MyTypes::Monster>& data) = 0;
     virtual void deserialize(Buf buf, std::vector<MyTypes::Monster>& res) = 0;
     virtual TestInfo testInfo() const = 0;
+    //max bytes that fit in preallocated output buffer, growable buffers are unlimited.
+    //datasets that might not fit (see MyTypes::serializedSizeUpperBound) are skipped
+    virtual size_t bufferCapacity() const {
+        return std::numeric_limits<size_t>::max();
+    }
+    //read single field or monster at index directly from serialized buffer, used by access measurement.
+    //tests that can do it without decoding everything override these and return true from hasDirectAccess,
+    //others decode whole buffer into new vector, as consumer without direct access would do
+    virtual bool hasDirectAccess() const {
+        return false;
+    }
+    virtual int16_t readHp(Buf buf, size_t index) {
+        return decodeAll(buf).at(index).hp;
+    }
+    virtual MyTypes::Vec3 readPos(Buf buf, size_t index) {
+        return decodeAll(buf).at(index).pos;
+    }
+    virtual void readMonster(Buf buf, size_t index, MyTypes::Monster& res) {
+        res = std::move(decodeAll(buf).at(index));
+    }
+    //serializes directly into sink, returns written bytes or 0 if data doesn't fit.
+    //default implementation serializes into test's own buffer and copies it
+    virtual size_t serializeInto(const std::vector<MyTypes::Monster>& data, OutputSink sink) {
+        if (MyTypes::serializedSizeUpperBound(data) > bufferCapacity())
+            return 0;
+        auto buf = serialize(data);
+        if (buf.bytesCount > sink.capacity)
+            return 0;
+        std::memcpy(sink.ptr, buf.ptr, buf.bytesCount);
+        return buf.bytesCount;
+    }
+    //serializes range of monsters directly into sink in same format as vector of them, so deserialize can read
+    //result; returns written bytes or 0 if it doesn't fit. used by chunked serialization,
+    //default implementation copies range into vector
+    virtual size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) {
+        _rangeCopy.assign(range.begin(), range.end());
+        return serializeInto(_rangeCopy, sink);
+    }
+    //decodes serializeRangeInto result into preallocated slots, returns false if buffer is invalid or
+    //it doesn't contain exactly res.size() monsters. default implementation decodes into vector and moves monsters
+    virtual bool deserializeRange(Buf buf, std::span<MyTypes::Monster> res) {
+        deserialize(buf, _rangeCopy);
+        if (_rangeCopy.size() != res.size())
+            return false;
+        std::move(_rangeCopy.begin(), _rangeCopy.end(), res.begin());
+        return true;
+    }
+    //serialization into list of segments, big arrays might be referenced in place instead of copied.
+    //concatenated segments are same as serialize result, they are valid until next call or until data changes.
+    //returns false if test doesn't support it
+    virtual bool serializeGather(const std::vector<MyTypes::Monster>&, std::vector<Buf>&) {
+        return false;
+    }
+    //zero-copy decoding, strings and containers of result point into buf.
+    //returns false if test doesn't support it or buffer is invalid
+    virtual bool deserializeView(Buf, MyTypes::MonstersView&) {
+        return false;
+    }
+    //deserialization into pmr types, strings and containers take memory from memory resource of res.
+    //returns false if test doesn't support it
+    virtual bool deserializePmr(Buf, std::pmr::vector<MyTypes::pmr::Monster>&) {
+        return false;
+    }
     virtual ~ISerializerTest() = default;
+private:
+    std::vector<MyTypes::Monster> decodeAll(Buf buf) {
+        std::vector<MyTypes::Monster> res{};
+        deserialize(buf, res);
+        return res;
+    }
+
+    std::vector<MyTypes::Monster> _rangeCopy{};
 };
 
-int runTest(ISerializerTest& archive);
+//creates independent test instances, used by measurements that run on several threads
+using TestFactory = std::function<std::unique_ptr<ISerializerTest>()>;
+
+template<typename T>
+TestFactory makeTestFactory() {
+    return [] { return std::make_unique<T>(); };
+}
+
+int runTest(ISerializerTest& archive, const TestFactory& factory = {});
 std::string getLibraryName(SerializationLibrary);
 
 #endif //CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TEST_H
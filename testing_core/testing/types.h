@@ -24,6 +24,8 @@
 #ifndef CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TYPES_H
 #define CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TYPES_H
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 #include <valarray>
@@ -86,7 +88,42 @@ namespace MyTypes {
 
     };
 
-    std::vector<Monster> createMonsters(size_t count);
+    //longest string or container that createMonsters can generate,
+    //serializers that require max size for containers use it
+    constexpr size_t MAX_CONTAINER_SIZE = 4096;
+
+    enum class WorkloadProfile {
+        //1-9 chars names, 1-9 inventory items, weapons and path points, floats in [-1, 1]
+        DEFAULT,
+        //16-256 chars names, 16-128 chars weapon names
+        STRING_HEAVY,
+        //1-4KB inventory
+        BLOB_HEAVY,
+        //64-256 path points, floats in [-1000, 1000]
+        FLOAT_HEAVY,
+        //1-2 chars names, at most one inventory item, weapon and path point
+        TINY_MESSAGE,
+        //weapons and path points count follows zipf distribution in [1, 256]
+        ZIPF_SKEWED,
+    };
+
+    //seed 0 generates same data as previous versions of this benchmark
+    std::vector<Monster> createMonsters(size_t count, WorkloadProfile profile = WorkloadProfile::DEFAULT,
+                                        uint32_t seed = 0);
+
+    //monsters are generated in shards of GENERATOR_SHARD_SIZE, each with its own engine seeded by shard index,
+    //so result only depends on count, profile and seed, but not on threads count (0 uses all cores).
+    //it differs from createMonsters result, which uses single engine for all monsters
+    constexpr size_t GENERATOR_SHARD_SIZE = 4096;
+    std::vector<Monster> createMonstersParallel(size_t count, WorkloadProfile profile = WorkloadProfile::DEFAULT,
+                                                uint32_t seed = 0, size_t threads = 0);
+
+    std::string getWorkloadProfileName(WorkloadProfile profile);
+    bool parseWorkloadProfile(const std::string& name, WorkloadProfile& profile);
+
+    //size of data when every length is written as 8 byte size_t,
+    //it is an upper bound for compact binary formats (handwritten, bitsery, zpp_bits)
+    size_t serializedSizeUpperBound(std::span<const Monster> data);
 }
 
 #endif //CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_TYPES_H
@@ -0,0 +1,122 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_VIEWS_H
+#define CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_VIEWS_H
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <testing/types.h>
+
+namespace MyTypes {
+
+    static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must be three packed floats");
+
+    //Vec3 array inside serialized buffer, it might be unaligned so elements are copied out
+    class PackedVec3View {
+    public:
+        PackedVec3View() = default;
+        PackedVec3View(const uint8_t* data, size_t size)
+            : _data{data},
+              _size{size} {
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        Vec3 operator[](size_t index) const {
+            Vec3 res;
+            std::memcpy(&res, _data + index * sizeof(Vec3), sizeof(Vec3));
+            return res;
+        }
+
+    private:
+        const uint8_t* _data{};
+        size_t _size{};
+    };
+
+    //same as Weapon, but strings point into serialized buffer
+    struct WeaponView {
+        std::string_view name;
+        int16_t damage;
+    };
+
+    //same as Monster, but strings and containers point into serialized buffer or MonstersView::weapons
+    struct MonsterView {
+        Vec3 pos;
+        int16_t mana;
+        int16_t hp;
+        std::string_view name;
+        std::span<const uint8_t> inventory;
+        Color color;
+        std::span<const WeaponView> weapons;
+        WeaponView equipped;
+        PackedVec3View path;
+    };
+
+    //result of zero-copy decoding, it is valid while serialized buffer is alive.
+    //weapons of all monsters are stored in one vector, reusing same object avoids heap allocations
+    struct MonstersView {
+        std::vector<MonsterView> monsters;
+        std::vector<WeaponView> weapons;
+
+        //reserve for the worst case, so that weapons are never reallocated while monsters point to them
+        void reset(size_t monstersCount, size_t maxWeapons) {
+            monsters.resize(monstersCount);
+            weapons.clear();
+            weapons.reserve(maxWeapons);
+        }
+
+        //returns false if there is no reserved space for more weapons
+        bool canAddWeapons(size_t count) const {
+            return weapons.capacity() - weapons.size() >= count;
+        }
+    };
+
+    inline bool operator==(const WeaponView& lhs, const Weapon& rhs) {
+        return lhs.name == rhs.name && lhs.damage == rhs.damage;
+    }
+
+    inline bool operator==(const MonsterView& lhs, const Monster& rhs) {
+        if (lhs.path.size() != rhs.path.size())
+            return false;
+        for (size_t i = 0; i < rhs.path.size(); ++i) {
+            if (!(lhs.path[i] == rhs.path[i]))
+                return false;
+        }
+        return lhs.pos == rhs.pos &&
+               lhs.mana == rhs.mana &&
+               lhs.hp == rhs.hp &&
+               lhs.name == rhs.name &&
+               std::equal(lhs.inventory.begin(), lhs.inventory.end(), rhs.inventory.begin(), rhs.inventory.end()) &&
+               lhs.color == rhs.color &&
+               std::equal(lhs.weapons.begin(), lhs.weapons.end(), rhs.weapons.begin(), rhs.weapons.end()) &&
+               lhs.equipped == rhs.equipped;
+    }
+
+}
+
+#endif //CPP_SERIALIZERS_BENCHMARK_TESTING_CORE_VIEWS_H
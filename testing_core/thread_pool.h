@@ -0,0 +1,121 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef CPP_SERIALIZERS_BENCHMARK_THREAD_POOL_H
+#define CPP_SERIALIZERS_BENCHMARK_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//fixed size pool for fork-join jobs. calling thread works as worker 0, so pool of one worker starts no threads,
+//and runs everything inline. tasks of a job are claimed one by one, so faster workers take more of them
+class ThreadPool {
+public:
+    //fn(taskIndex, workerIndex)
+    using Task = std::function<void(size_t, size_t)>;
+
+    explicit ThreadPool(size_t workers) {
+        for (size_t w = 1; w < workers; ++w)
+            _threads.emplace_back([this, w] { workerLoop(w); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _jobReady.notify_all();
+        for (auto& t: _threads)
+            t.join();
+    }
+
+    size_t workers() const {
+        return _threads.size() + 1;
+    }
+
+    //runs fn for every task in [0, tasksCount) and returns when all of them are finished
+    void run(size_t tasksCount, const Task& fn) {
+        if (_threads.empty()) {
+            for (size_t i = 0; i < tasksCount; ++i)
+                fn(i, 0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _task = &fn;
+            _tasksCount = tasksCount;
+            _nextTask = 0;
+            _busyWorkers = _threads.size();
+            ++_job;
+        }
+        _jobReady.notify_all();
+        runTasks(0);
+        std::unique_lock<std::mutex> lock{_mutex};
+        _jobDone.wait(lock, [this] { return _busyWorkers == 0; });
+        _task = nullptr;
+    }
+
+private:
+    void workerLoop(size_t worker) {
+        size_t seenJob = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _jobReady.wait(lock, [&] { return _stop || _job != seenJob; });
+                if (_stop)
+                    return;
+                seenJob = _job;
+            }
+            runTasks(worker);
+            std::lock_guard<std::mutex> lock{_mutex};
+            if (--_busyWorkers == 0)
+                _jobDone.notify_one();
+        }
+    }
+
+    void runTasks(size_t worker) {
+        for (auto i = _nextTask.fetch_add(1); i < _tasksCount; i = _nextTask.fetch_add(1))
+            (*_task)(i, worker);
+    }
+
+    std::vector<std::thread> _threads{};
+    std::mutex _mutex{};
+    std::condition_variable _jobReady{};
+    std::condition_variable _jobDone{};
+    //job state is written under mutex before workers are woken up
+    const Task* _task{};
+    size_t _tasksCount{};
+    std::atomic<size_t> _nextTask{};
+    size_t _busyWorkers{};
+    size_t _job{};
+    bool _stop{false};
+};
+
+#endif //CPP_SERIALIZERS_BENCHMARK_THREAD_POOL_H
@@ -0,0 +1,111 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "benchmarks.h"
+#include <atomic>
+#include <barrier>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct ScalingResult {
+        double serOpsPerSec;
+        double desOpsPerSec;
+    };
+
+    ScalingResult runThreads(const TestFactory& factory, const std::vector<MyTypes::Monster>& data,
+                             size_t threadsCount, size_t samples, std::atomic<bool>& failed) {
+        //all worker threads and this thread synchronize on start, after serialization and after deserialization
+        std::barrier sync{static_cast<std::ptrdiff_t>(threadsCount + 1)};
+        std::vector<std::thread> threads{};
+        threads.reserve(threadsCount);
+        for (size_t t = 0; t < threadsCount; ++t) {
+            threads.emplace_back([&] {
+                auto testCase = factory();
+                //each thread works on its own copy, allocated by this thread
+                const std::vector<MyTypes::Monster> localData{data};
+                std::vector<MyTypes::Monster> res{};
+                auto buf = testCase->serialize(localData);
+                testCase->deserialize(buf, res);
+                if (res != localData)
+                    failed = true;
+
+                sync.arrive_and_wait();
+                for (size_t i = 0; i < samples; ++i)
+                    testCase->serialize(localData);
+                sync.arrive_and_wait();
+                for (size_t i = 0; i < samples; ++i)
+                    testCase->deserialize(buf, res);
+                sync.arrive_and_wait();
+            });
+        }
+        sync.arrive_and_wait();
+        auto start = BenchClock::now();
+        sync.arrive_and_wait();
+        auto serEnd = BenchClock::now();
+        sync.arrive_and_wait();
+        auto desEnd = BenchClock::now();
+        for (auto& t: threads)
+            t.join();
+
+        const auto totalOps = static_cast<double>(threadsCount * samples) * 1e9;
+        return {totalOps / static_cast<double>(elapsedNs(start, serEnd)),
+                totalOps / static_cast<double>(elapsedNs(serEnd, desEnd))};
+    }
+
+}
+
+void runThroughputScaling(const TestFactory& factory, const std::vector<MyTypes::Monster>& data,
+                          size_t maxThreads, size_t samples) {
+    if (!factory) {
+        std::cout << "* threads: skipped, test doesn't provide factory" << std::endl;
+        return;
+    }
+    std::vector<size_t> threadCounts{};
+    for (size_t n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    ScalingResult single{};
+    for (auto n: threadCounts) {
+        std::atomic<bool> failed{false};
+        auto res = runThreads(factory, data, n, samples, failed);
+        if (failed) {
+            std::cout << "* threads " << n << ": result != data, abort." << std::endl;
+            return;
+        }
+        if (n == 1)
+            single = res;
+        const auto nd = static_cast<double>(n);
+        std::ostringstream line{};
+        line << std::fixed << std::setprecision(0)
+             << "* threads " << n << ": ser " << res.serOpsPerSec << " ops/s"
+             << std::setprecision(1) << " (efficiency " << 100.0 * res.serOpsPerSec / (nd * single.serOpsPerSec) << "%)"
+             << std::setprecision(0) << ", des " << res.desOpsPerSec << " ops/s"
+             << std::setprecision(1) << " (efficiency " << 100.0 * res.desOpsPerSec / (nd * single.desOpsPerSec) << "%)";
+        std::cout << line.str() << std::endl;
+    }
+}
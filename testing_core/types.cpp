@@ -25,6 +25,9 @@
 #include <random>
 #include <functional>
 #include <iostream>
+#include <optional>
+#include <thread>
+#include <atomic>
 #include "uniform_distributions.h"
 
 
@@ -42,41 +45,165 @@ typedef std::mersenne_twister_engine<
         0xefc60000UL, 18, 1812433253UL>
         engine;
 
+namespace {
+
+    //lengths of generated strings and containers, and range of generated floats.
+    //UniformIntDistribution upper bound is exclusive, so profile ranges are [min, max + 1)
+    struct Profile {
+        UniformIntDistribution<int> nameLen{1, 10};
+        UniformIntDistribution<int> weaponNameLen{1, 10};
+        UniformIntDistribution<int> inventoryLen{1, 10};
+        UniformIntDistribution<int> pathLen{1, 10};
+        UniformIntDistribution<int> weaponsLen{1, 10};
+        UniformRealDistribution<float> coord{-1.0f, 1.0f};
+        //when set, it is used for weapons and path lengths instead
+        std::optional<ZipfDistribution<int>> skewedLen{};
+    };
+
+    Profile createProfile(MyTypes::WorkloadProfile profile) {
+        using MyTypes::WorkloadProfile;
+        switch (profile) {
+            case WorkloadProfile::DEFAULT:
+                return Profile{};
+            case WorkloadProfile::STRING_HEAVY:
+                return Profile{.nameLen{16, 257}, .weaponNameLen{16, 129}};
+            case WorkloadProfile::BLOB_HEAVY:
+                return Profile{.inventoryLen{1024, static_cast<int>(MyTypes::MAX_CONTAINER_SIZE) + 1}};
+            case WorkloadProfile::FLOAT_HEAVY:
+                return Profile{.pathLen{64, 257}, .coord{-1000.0f, 1000.0f}};
+            case WorkloadProfile::TINY_MESSAGE:
+                return Profile{.nameLen{1, 3}, .weaponNameLen{1, 3}, .inventoryLen{0, 2}, .pathLen{0, 2},
+                               .weaponsLen{0, 2}};
+            case WorkloadProfile::ZIPF_SKEWED:
+                return Profile{.skewedLen{ZipfDistribution<int>{256}}};
+        }
+        throw "Unknown workload profile";
+    }
+
+}
+
 namespace MyTypes {
 
-    static Weapon createRandomWeapon(engine &e) {
+    static Weapon createRandomWeapon(engine &e, Profile &p) {
         Weapon res;
         res.damage = rand_nr(e);
-        std::generate_n(std::back_inserter(res.name), rand_len(e), std::bind(rand_char, std::ref(e)));
+        std::generate_n(std::back_inserter(res.name), p.weaponNameLen(e), std::bind(rand_char, std::ref(e)));
         return res;
     }
 
-    Monster createRandomMonster(engine &e) {
+    static int randomContainerLen(engine &e, Profile &p, UniformIntDistribution<int> &len) {
+        return p.skewedLen ? (*p.skewedLen)(e) : len(e);
+    }
+
+    Monster createRandomMonster(engine &e, Profile &p) {
         Monster res{};
-        std::generate_n(std::back_inserter(res.name), rand_len(e), std::bind(rand_char, std::ref(e)));
-        res.pos.x = rand_float(e);
-        res.pos.y = rand_float(e);
-        res.pos.z = rand_float(e);
+        std::generate_n(std::back_inserter(res.name), p.nameLen(e), std::bind(rand_char, std::ref(e)));
+        res.pos.x = p.coord(e);
+        res.pos.y = p.coord(e);
+        res.pos.z = p.coord(e);
         res.color = static_cast<MyTypes::Color>(rand_len(e) % static_cast<int>(3));
         res.hp = rand_nr(e) % 1000;
         res.mana = std::abs(rand_nr(e) % 500);
         static_assert(std::is_copy_constructible<engine>::value, "");
-        std::generate_n(std::back_inserter(res.inventory), rand_len(e), std::bind(rand_len, std::ref(e)));
-        std::generate_n(std::back_inserter(res.path), rand_len(e), [&]() {
-            return Vec3{rand_float(e), rand_float(e), rand_float(e)};
+        std::generate_n(std::back_inserter(res.inventory), p.inventoryLen(e), std::bind(rand_len, std::ref(e)));
+        std::generate_n(std::back_inserter(res.path), randomContainerLen(e, p, p.pathLen), [&]() {
+            return Vec3{p.coord(e), p.coord(e), p.coord(e)};
         });
-        res.equipped = createRandomWeapon(e);
-        std::generate_n(std::back_inserter(res.weapons), rand_len(e), std::bind(createRandomWeapon, std::ref(e)));
+        res.equipped = createRandomWeapon(e, p);
+        std::generate_n(std::back_inserter(res.weapons), randomContainerLen(e, p, p.weaponsLen),
+                        [&]() { return createRandomWeapon(e, p); });
         return res;
     }
 
-    std::vector<MyTypes::Monster> createMonsters(size_t count) {
+    std::vector<MyTypes::Monster> createMonsters(size_t count, WorkloadProfile profile, uint32_t seed) {
         std::vector<MyTypes::Monster> res{};
-        //always the same seed
-        std::seed_seq seed{1,2,3};
-        engine e{seed};
+        //always the same seed, unless other is requested
+        std::seed_seq defaultSeed{1,2,3};
+        std::seed_seq customSeed{1u, 2u, 3u, seed};
+        engine e{seed == 0 ? defaultSeed : customSeed};
+        auto p = createProfile(profile);
+
+        res.reserve(count);
+        std::generate_n(std::back_inserter(res), count, [&]() { return createRandomMonster(e, p); });
+        return res;
+    }
+
+    std::vector<MyTypes::Monster> createMonstersParallel(size_t count, WorkloadProfile profile, uint32_t seed,
+                                                         size_t threads) {
+        std::vector<MyTypes::Monster> res(count);
+        const auto shards = (count + GENERATOR_SHARD_SIZE - 1) / GENERATOR_SHARD_SIZE;
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, shards);
+
+        //threads take next shard until all are done, shard content doesn't depend on which thread generates it
+        std::atomic<size_t> nextShard{0};
+        auto generate = [&]() {
+            auto p = createProfile(profile);
+            for (auto shard = nextShard++; shard < shards; shard = nextShard++) {
+                std::seed_seq shardSeed{1u, 2u, 3u, seed, static_cast<uint32_t>(shard)};
+                engine e{shardSeed};
+                const auto first = shard * GENERATOR_SHARD_SIZE;
+                const auto last = std::min(count, first + GENERATOR_SHARD_SIZE);
+                for (auto i = first; i < last; ++i)
+                    res[i] = createRandomMonster(e, p);
+            }
+        };
+        std::vector<std::thread> workers{};
+        for (size_t i = 1; i < threads; ++i)
+            workers.emplace_back(generate);
+        generate();
+        for (auto& w: workers)
+            w.join();
+        return res;
+    }
+
+    std::string getWorkloadProfileName(WorkloadProfile profile) {
+        switch (profile) {
+            case WorkloadProfile::DEFAULT:
+                return "default";
+            case WorkloadProfile::STRING_HEAVY:
+                return "string-heavy";
+            case WorkloadProfile::BLOB_HEAVY:
+                return "blob-heavy";
+            case WorkloadProfile::FLOAT_HEAVY:
+                return "float-heavy";
+            case WorkloadProfile::TINY_MESSAGE:
+                return "tiny-message";
+            case WorkloadProfile::ZIPF_SKEWED:
+                return "zipf-skewed";
+        }
+        throw "Unknown workload profile";
+    }
+
+    bool parseWorkloadProfile(const std::string &name, WorkloadProfile &profile) {
+        for (auto p: {WorkloadProfile::DEFAULT, WorkloadProfile::STRING_HEAVY, WorkloadProfile::BLOB_HEAVY,
+                      WorkloadProfile::FLOAT_HEAVY, WorkloadProfile::TINY_MESSAGE, WorkloadProfile::ZIPF_SKEWED}) {
+            if (getWorkloadProfileName(p) == name) {
+                profile = p;
+                return true;
+            }
+        }
+        return false;
+    }
 
-        std::generate_n(std::back_inserter(res), count, std::bind(createRandomMonster, std::ref(e)));
+    size_t serializedSizeUpperBound(std::span<const Monster> data) {
+        constexpr size_t sizeBytes = sizeof(size_t);
+        constexpr size_t vec3Bytes = 3 * sizeof(float);
+        auto weaponBytes = [](const Weapon& w) {
+            return sizeof(w.damage) + sizeBytes + w.name.size();
+        };
+        size_t res = sizeBytes;
+        for (auto& m: data) {
+            res += sizeof(m.hp) + sizeof(m.mana) + sizeof(m.color) + vec3Bytes;
+            res += sizeBytes + m.name.size();
+            res += sizeBytes + m.inventory.size();
+            res += sizeBytes + m.path.size() * vec3Bytes;
+            res += weaponBytes(m.equipped);
+            res += sizeBytes;
+            for (auto& w: m.weapons)
+                res += weaponBytes(w);
+        }
         return res;
     }
 
@@ -25,6 +25,8 @@
 
 #include <type_traits>
 #include <cassert>
+#include <algorithm>
+#include <vector>
 
 //simple implementations of uniform distribution functions to generate same test data on different platforms.
 template <typename TValue>
@@ -76,4 +78,34 @@ private:
     TValue _b;
 };
 
+//zipf distribution with exponent 1 in range [1, n], weights are 1/k so generated data doesn't depend on libm.
+template <typename TValue>
+class ZipfDistribution {
+public:
+    static_assert(std::is_integral<TValue>::value, "");
+    explicit ZipfDistribution(TValue n)
+    {
+        assert(n > 0);
+        _cdf.reserve(static_cast<size_t>(n));
+        double sum{};
+        for (TValue k = 1; k <= n; ++k) {
+            sum += 1.0 / static_cast<double>(k);
+            _cdf.push_back(sum);
+        }
+        for (auto& v: _cdf)
+            v /= sum;
+    }
+
+    template <typename Engine>
+    TValue operator()(Engine& eng) {
+        auto u = _uniform(eng);
+        auto it = std::lower_bound(_cdf.begin(), _cdf.end(), u);
+        auto index = std::min<size_t>(static_cast<size_t>(std::distance(_cdf.begin(), it)), _cdf.size() - 1);
+        return static_cast<TValue>(index + 1);
+    }
+private:
+    std::vector<double> _cdf;
+    UniformRealDistribution<double> _uniform{0.0, 1.0};
+};
+
 #endif //CPP_SERIALIZERS_BENCHMARK_UNIFORM_DISTRIBUTIONS_H
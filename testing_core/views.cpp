@@ -0,0 +1,71 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+#include "benchmarks.h"
+#include "alloc_tracking.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+void runViewBenchmark(ISerializerTest& testCase, const std::vector<MyTypes::Monster>& data, Buf buf,
+                      size_t samples) {
+    //serialization might return internal buffer that is overwritten, keep own copy
+    std::vector<uint8_t> input(buf.ptr, buf.ptr + buf.bytesCount);
+    buf = Buf{input.data(), input.size()};
+
+    MyTypes::MonstersView view{};
+    if (!testCase.deserializeView(buf, view)) {
+        std::cout << "* view decode: not supported" << std::endl;
+        return;
+    }
+    if (!std::equal(view.monsters.begin(), view.monsters.end(), data.begin(), data.end())) {
+        std::cout << "* view decode: result != data, abort." << std::endl;
+        return;
+    }
+
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.deserializeView(buf, view);
+    const auto viewNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    //deserialize on top of old object, same as default measurement
+    std::vector<MyTypes::Monster> res{};
+    testCase.deserialize(buf, res);
+    start = BenchClock::now();
+    for (size_t i = 0; i < samples; ++i)
+        testCase.deserialize(buf, res);
+    const auto desNs = static_cast<double>(elapsedNs(start, BenchClock::now()));
+
+    std::ostringstream line{};
+    line << std::fixed << std::setprecision(1) << "* view decode: " << viewNs / static_cast<double>(samples)
+         << " ns/call (" << desNs / viewNs << "x faster than owning decode)";
+    if (allocTrackingSupported()) {
+        //separate pass, so counting doesn't affect timing
+        const auto countedSamples = std::min<size_t>(samples, 100);
+        startAllocTracking();
+        for (size_t i = 0; i < countedSamples; ++i)
+            testCase.deserializeView(buf, view);
+        const auto stats = stopAllocTracking();
+        line << ", " << static_cast<double>(stats.allocations) / static_cast<double>(countedSamples)
+             << " allocations per call";
+    }
+    std::cout << line.str() << std::endl;
+}
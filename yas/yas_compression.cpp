@@ -55,12 +55,23 @@ public:
         yas::mem_ostream os;
         yas::binary_oarchive<yas::mem_ostream, yas::binary | yas::no_header | yas::compacted> oa(os);
         oa & data;
-        if (_buf.size == 0)
-            _buf = os.get_shared_buffer();
+        _buf = os.get_shared_buffer();
 
         return {reinterpret_cast<const uint8_t *>(_buf.data.get()), _buf.size};
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        //mem_ostream over external memory throws when it runs out of space
+        yas::mem_ostream os(sink.ptr, sink.capacity);
+        try {
+            yas::binary_oarchive<yas::mem_ostream, yas::binary | yas::no_header | yas::compacted> oa(os);
+            oa & data;
+        } catch (const std::exception&) {
+            return 0;
+        }
+        return os.get_intrusive_buffer().size;
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
 
         yas::mem_istream is(buf.ptr, buf.bytesCount);
@@ -84,5 +95,5 @@ private:
 
 int main() {
     YasArchiverCompression test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<YasArchiverCompression>());
 }
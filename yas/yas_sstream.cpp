@@ -21,6 +21,7 @@
 //SOFTWARE.
 
 #include <testing/test.h>
+#include <testing/memory_stream.h>
 
 #include <sstream>
 #include <yas/std_streams.hpp>
@@ -60,16 +61,29 @@ public:
         yas::binary_oarchive<yas::std_ostream_adapter, yas::binary | yas::no_header> oa(os);
         oa & data;
 
-        if (_buf.empty())
-            _buf = ss.str();
+        //move out stream's string, so result is always up to date without extra copy
+        _buf = std::move(ss).str();
         return {
                 reinterpret_cast<uint8_t *>(std::addressof(*_buf.begin())),
                 _buf.size()
         };
     }
 
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        MemoryStreamBuf sb{sink};
+        std::ostream ss{&sb};
+        yas::std_ostream_adapter os{ss};
+        try {
+            yas::binary_oarchive<yas::std_ostream_adapter, yas::binary | yas::no_header> oa(os);
+            oa & data;
+        } catch (const std::exception&) {
+            return 0;
+        }
+        return sb.overflowed() ? 0 : sb.written();
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
-        std::stringstream ss{_buf};
+        std::stringstream ss{std::string{reinterpret_cast<const char *>(buf.ptr), buf.bytesCount}};
         yas::std_istream_adapter is(ss);
         yas::binary_iarchive<yas::std_istream_adapter, yas::binary | yas::no_header> ia(is);
 
@@ -91,5 +105,5 @@ private:
 
 int main() {
     YasArchiverSStream test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<YasArchiverSStream>());
 }
@@ -0,0 +1,166 @@
+//MIT License
+//
+//Copyright (c) 2017 Mindaugas Vinkelis
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+//
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#ifndef ZPP_BITS_ACCESS_UTILS_H
+#define ZPP_BITS_ACCESS_UTILS_H
+
+#include <testing/test.h>
+#include <cstring>
+#include <span>
+
+#include "zpp_bits.h"
+
+//reads single monster fields directly from zpp_bits buffer.
+//zpp_bits writes members in declaration order without padding, and container sizes as uint32_t,
+//so preceding monsters are skipped by reading only their sizes
+class ZppBitsMonsterReader {
+public:
+    explicit ZppBitsMonsterReader(Buf buf)
+            : _pos{buf.ptr},
+              _end{buf.ptr + buf.bytesCount} {
+    }
+
+    //moves to the beginning of monster at index
+    bool seekMonster(size_t index) {
+        SizeType size{};
+        if (!read(size) || index >= size)
+            return false;
+        for (size_t i = 0; i < index; ++i) {
+            if (!skipMonster())
+                return false;
+        }
+        return true;
+    }
+
+    int16_t readHp() {
+        int16_t hp{};
+        if (skip(sizeof(MyTypes::Monster::pos) + sizeof(MyTypes::Monster::mana)))
+            read(hp);
+        return hp;
+    }
+
+    MyTypes::Vec3 readPos() {
+        MyTypes::Vec3 pos{};
+        read(pos.x) && read(pos.y) && read(pos.z);
+        return pos;
+    }
+
+    void readMonster(MyTypes::Monster &res) {
+        (void) zpp::bits::in{std::span{_pos, _end}}(res);
+    }
+
+    //zero-copy decoding of whole buffer
+    bool readMonstersView(MyTypes::MonstersView &res) {
+        SizeType size{};
+        if (!read(size))
+            return false;
+        //each weapon takes at least name size and damage
+        res.reset(size, static_cast<size_t>(_end - _pos) / (sizeof(SizeType) + sizeof(MyTypes::Weapon::damage)));
+        for (auto &m: res.monsters) {
+            if (!readMonsterView(m, res))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    using SizeType = uint32_t;
+
+    bool readMonsterView(MyTypes::MonsterView &m, MyTypes::MonstersView &res) {
+        SizeType size{};
+        if (!read(m.pos.x) || !read(m.pos.y) || !read(m.pos.z) || !read(m.mana) || !read(m.hp) ||
+            !readString(m.name) || !read(size))
+            return false;
+        m.inventory = {_pos, size};
+        if (!skip(size) || !read(m.color) || !read(size) || !res.canAddWeapons(size))
+            return false;
+        auto weapons = res.weapons.data() + res.weapons.size();
+        for (SizeType i = 0; i < size; ++i) {
+            if (!readWeaponView(res.weapons.emplace_back()))
+                return false;
+        }
+        m.weapons = {weapons, size};
+        if (!readWeaponView(m.equipped) || !read(size))
+            return false;
+        m.path = {_pos, size};
+        return skip(size * sizeof(MyTypes::Vec3));
+    }
+
+    bool readWeaponView(MyTypes::WeaponView &w) {
+        return readString(w.name) && read(w.damage);
+    }
+
+    bool readString(std::string_view &str) {
+        SizeType size{};
+        if (!read(size))
+            return false;
+        auto data = _pos;
+        if (!skip(size))
+            return false;
+        str = {reinterpret_cast<const char *>(data), size};
+        return true;
+    }
+
+    template<typename T>
+    bool read(T &v) {
+        if (static_cast<size_t>(_end - _pos) < sizeof(T))
+            return false;
+        std::memcpy(&v, _pos, sizeof(T));
+        _pos += sizeof(T);
+        return true;
+    }
+
+    bool skip(size_t bytes) {
+        if (static_cast<size_t>(_end - _pos) < bytes)
+            return false;
+        _pos += bytes;
+        return true;
+    }
+
+    bool skipSized(size_t elementSize) {
+        SizeType size{};
+        return read(size) && skip(size * elementSize);
+    }
+
+    bool skipWeapon() {
+        return skipSized(sizeof(char)) && skip(sizeof(MyTypes::Weapon::damage));
+    }
+
+    bool skipMonster() {
+        if (!skip(sizeof(MyTypes::Monster::pos) + sizeof(MyTypes::Monster::mana) + sizeof(MyTypes::Monster::hp)) ||
+            !skipSized(sizeof(char)) || !skipSized(sizeof(uint8_t)) || !skip(sizeof(MyTypes::Color)))
+            return false;
+        SizeType weapons{};
+        if (!read(weapons))
+            return false;
+        for (SizeType i = 0; i < weapons; ++i) {
+            if (!skipWeapon())
+                return false;
+        }
+        return skipWeapon() && skipSized(sizeof(MyTypes::Vec3));
+    }
+
+    const uint8_t *_pos;
+    const uint8_t *_end;
+};
+
+#endif //ZPP_BITS_ACCESS_UTILS_H
@@ -23,6 +23,13 @@
 #include "testing/test.h"
 
 #include "zpp_bits.h"
+#include "zpp_bits_access.h"
+
+//pmr types are not aggregates, so members are listed explicitly
+namespace MyTypes::pmr {
+    auto serialize(const Weapon &) -> zpp::bits::members<2>;
+    auto serialize(const Monster &) -> zpp::bits::members<9>;
+}
 
 class ZppBitsFixedArchiver : public ISerializerTest {
 public:
@@ -32,10 +39,69 @@ public:
         return { std::data(m_data), out.position() };
     }
 
+    size_t serializeRangeInto(std::span<const MyTypes::Monster> range, OutputSink sink) override {
+        //same as vector: 4 byte size followed by elements
+        zpp::bits::out out{std::span{sink.ptr, sink.capacity}};
+        if (zpp::bits::failure(out(static_cast<uint32_t>(range.size()))))
+            return 0;
+        for (auto &m: range) {
+            if (zpp::bits::failure(out(m)))
+                return 0;
+        }
+        return out.position();
+    }
+
+    bool deserializePmr(Buf buf, std::pmr::vector<MyTypes::pmr::Monster> &res) override {
+        return !zpp::bits::failure(zpp::bits::in{std::span{buf.ptr, buf.bytesCount}}(res));
+    }
+
+    bool deserializeRange(Buf buf, std::span<MyTypes::Monster> res) override {
+        zpp::bits::in in{std::span{buf.ptr, buf.bytesCount}};
+        uint32_t size{};
+        if (zpp::bits::failure(in(size)) || size != res.size())
+            return false;
+        for (auto &m: res) {
+            if (zpp::bits::failure(in(m)))
+                return false;
+        }
+        return true;
+    }
+
+    size_t serializeInto(const std::vector<MyTypes::Monster> &data, OutputSink sink) override {
+        zpp::bits::out out{std::span{sink.ptr, sink.capacity}};
+        if (zpp::bits::failure(out(data)))
+            return 0;
+        return out.position();
+    }
+
     void deserialize(Buf buf, std::vector<MyTypes::Monster> &resVec) override {
         (void) zpp::bits::in{std::span{buf.ptr, buf.bytesCount}}(resVec);
     }
 
+    bool hasDirectAccess() const override {
+        return true;
+    }
+
+    int16_t readHp(Buf buf, size_t index) override {
+        ZppBitsMonsterReader reader{buf};
+        return reader.seekMonster(index) ? reader.readHp() : int16_t{};
+    }
+
+    MyTypes::Vec3 readPos(Buf buf, size_t index) override {
+        ZppBitsMonsterReader reader{buf};
+        return reader.seekMonster(index) ? reader.readPos() : MyTypes::Vec3{};
+    }
+
+    void readMonster(Buf buf, size_t index, MyTypes::Monster &res) override {
+        ZppBitsMonsterReader reader{buf};
+        if (reader.seekMonster(index))
+            reader.readMonster(res);
+    }
+
+    bool deserializeView(Buf buf, MyTypes::MonstersView &res) override {
+        return ZppBitsMonsterReader{buf}.readMonstersView(res);
+    }
+
     TestInfo testInfo() const override {
         return {
                 SerializationLibrary::ZPP_BITS,
@@ -44,11 +110,15 @@ public:
         };
     }
 
+    size_t bufferCapacity() const override {
+        return sizeof(m_data);
+    }
+
 private:
     unsigned char m_data[150000];
 };
 
 int main() {
     ZppBitsFixedArchiver test;
-    return runTest(test);
+    return runTest(test, makeTestFactory<ZppBitsFixedArchiver>());
 }